@@ -0,0 +1,84 @@
+#include "arena.h"
+
+using namespace std;
+
+// Implementacija konstruktora klase NodeArena
+NodeArena::NodeArena(size_t bytes) : memory(new unsigned char[bytes]), capacity(bytes), top(0) {
+}
+
+// Implementacija konstruktora klase SearchTree (jedno mjesto više za korijen)
+SearchTree::SearchTree(size_t maxNodes)
+    : arenas{ NodeArena((maxNodes + 1) * sizeof(SearchNode)), NodeArena((maxNodes + 1) * sizeof(SearchNode)) },
+    active(0), rootNode(nullptr), nodeLimit(maxNodes) {
+    clear();
+}
+
+// Implementacija funkcije root
+SearchNode* SearchTree::root() {
+    return rootNode;
+}
+
+// Implementacija funkcije expand (false kad bi djeca prešla granicu čvorova, čvor ostaje list)
+bool SearchTree::expand(SearchNode* node, const Move* moves, size_t count) {
+    if (count > UINT16_MAX) {
+        return false;
+    }
+    SearchNode* children = arenas[active].allocate<SearchNode>(count);
+    if (!children) {
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        children[i] = SearchNode{ nullptr, moves[i], 0, 0.0f, 0, 0 };
+    }
+    node->children = children;
+    node->childCount = static_cast<uint16_t>(count);
+    return true;
+}
+
+// Implementacija funkcije advance (dijete korijena postaje novi korijen s cijelim podstablom)
+bool SearchTree::advance(size_t child) {
+    if (child >= rootNode->childCount) {
+        return false;
+    }
+    NodeArena& spare = arenas[active ^ 1];
+    spare.reset();
+    SearchNode* newRoot = spare.allocate<SearchNode>(1);
+    *newRoot = rootNode->children[child];
+    // Podstablo nije veće od cijelog stabla pa uvijek stane u rezervnu arenu iste veličine
+    copyChildren(rootNode->children[child], *newRoot, spare);
+    arenas[active].reset();
+    active ^= 1;
+    rootNode = newRoot;
+    return true;
+}
+
+// Implementacija funkcije copyChildren
+void SearchTree::copyChildren(const SearchNode& source, SearchNode& target, NodeArena& arena) {
+    if (!source.children) {
+        return;
+    }
+    target.children = arena.allocate<SearchNode>(source.childCount);
+    for (uint16_t i = 0; i < source.childCount; ++i) {
+        target.children[i] = source.children[i];
+        copyChildren(source.children[i], target.children[i], arena);
+    }
+}
+
+// Implementacija funkcije clear (oslobađa cijelo stablo u O(1) i ostavlja prazan korijen)
+void SearchTree::clear() {
+    arenas[0].reset();
+    arenas[1].reset();
+    active = 0;
+    rootNode = arenas[0].allocate<SearchNode>(1);
+    *rootNode = SearchNode{ nullptr, 0, 0, 0.0f, 0, 0 };
+}
+
+// Implementacija funkcije nodeCount
+size_t SearchTree::nodeCount() const {
+    return arenas[active].used() / sizeof(SearchNode);
+}
+
+// Implementacija funkcije maxNodes
+size_t SearchTree::maxNodes() const {
+    return nodeLimit;
+}
@@ -0,0 +1,78 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "movegen.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Arena: jedan blok fiksne veličine zauzet unaprijed, alokacija samo pomiče pokazivač,
+// a sve se oslobađa odjednom (reset u O(1)). Nije dijeljena među dretvama: svaka dretva
+// pretrage ima svoju arenu pa nema zaključavanja ni fragmentacije.
+class NodeArena {
+public:
+    explicit NodeArena(size_t bytes);
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    // nullptr kad nema mjesta; konstruktori se ne pozivaju, tip mora biti trivijalan
+    template <typename T>
+    T* allocate(size_t count) {
+        size_t start = (top + alignof(T) - 1) & ~(alignof(T) - 1);
+        if (start > capacity || count > (capacity - start) / sizeof(T)) {
+            return nullptr;
+        }
+        top = start + count * sizeof(T);
+        return reinterpret_cast<T*>(memory.get() + start);
+    }
+
+    void reset() {
+        top = 0;
+    }
+
+    size_t used() const {
+        return top;
+    }
+
+private:
+    std::unique_ptr<unsigned char[]> memory;
+    size_t capacity;
+    size_t top;
+};
+
+// Čvor stabla pretrage fiksne veličine; djeca jednog čvora leže uzastopno u areni
+struct SearchNode {
+    SearchNode* children;
+    Move move;
+    uint32_t visits;
+    float value;
+    uint16_t childCount;
+    uint16_t flags;
+};
+
+static_assert(sizeof(SearchNode) <= 24, "SearchNode must stay within the per-node memory budget");
+
+// Stablo pretrage nad dvije arene s najviše maxNodes čvorova u svakoj. Na kraju poteza
+// advance prepisuje podstablo odigranog poteza u rezervnu arenu i ostatak oslobađa u O(1),
+// pa se izračunato podstablo koristi u sljedećem potezu.
+class SearchTree {
+public:
+    explicit SearchTree(size_t maxNodes);
+
+    SearchNode* root();
+    bool expand(SearchNode* node, const Move* moves, size_t count);
+    bool advance(size_t child);
+    void clear();
+    size_t nodeCount() const;
+    size_t maxNodes() const;
+
+private:
+    NodeArena arenas[2];
+    int active;
+    SearchNode* rootNode;
+    size_t nodeLimit;
+
+    void copyChildren(const SearchNode& source, SearchNode& target, NodeArena& arena);
+};
+
+#endif
@@ -0,0 +1,446 @@
+#include "batch.h"
+#include "deadwood.h"
+#include "showdown.h"
+#include <cassert>
+#include <cstring>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const uint32_t NO_OFFSET = 0xFFFFFFFF;
+
+// Skupljanje (gather) čita 4 bajta od pomaka karte, pa špil i hrpa imaju 3 bajta zalihe na kraju
+const size_t GATHER_PADDING = 3;
+
+// Implementacija funkcije drawCounts
+// Smanjuje brojače hrpe i špila po trakama: 1 na hrpi ako aktivna igra uzima gornju kartu, inače u špilu
+void drawCounts(const uint8_t* active, const uint8_t* take, uint8_t* stockCount, uint8_t* pileCount, size_t games) {
+    size_t k = 0;
+#ifdef __SSE2__
+    for (; k + 16 <= games; k += 16) {
+        __m128i live = _mm_loadu_si128(reinterpret_cast<const __m128i*>(active + k));
+        __m128i fromPile = _mm_loadu_si128(reinterpret_cast<const __m128i*>(take + k));
+        __m128i fromStock = _mm_andnot_si128(fromPile, live);
+        fromPile = _mm_and_si128(fromPile, live);
+        __m128i* stockLanes = reinterpret_cast<__m128i*>(stockCount + k);
+        __m128i* pileLanes = reinterpret_cast<__m128i*>(pileCount + k);
+        _mm_storeu_si128(stockLanes, _mm_sub_epi8(_mm_loadu_si128(stockLanes), fromStock));
+        _mm_storeu_si128(pileLanes, _mm_sub_epi8(_mm_loadu_si128(pileLanes), fromPile));
+    }
+#endif
+    for (; k < games; ++k) {
+        stockCount[k] = static_cast<uint8_t>(stockCount[k] - (active[k] & (take[k] ^ 1)));
+        pileCount[k] = static_cast<uint8_t>(pileCount[k] - (active[k] & take[k]));
+    }
+}
+
+// Implementacija funkcije drawnCards
+// Izvučena karta svake igre (nakon drawCounts): vrh hrpe ili špila bez grananja; neaktivne igre
+// dobivaju kartu koja se ne koristi. Uz AVX2 osam igara odjednom skuplja se maskiranim gatherom.
+void drawnCards(const uint8_t* take, const uint8_t* stock, const uint8_t* stockCount, const uint8_t* pile,
+    const uint8_t* pileCount, uint8_t* drawn, size_t games) {
+    size_t k = 0;
+#ifdef __AVX2__
+    const __m256i rowStep = _mm256_set1_epi32(8 * NUM_CARDS);
+    const __m256i byteMask = _mm256_set1_epi32(0xFF);
+    const __m256i packOrder = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    __m256i rows = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(NUM_CARDS));
+    for (; k + 8 <= games; k += 8, rows = _mm256_add_epi32(rows, rowStep)) {
+        __m256i fromPile = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(take + k)));
+        fromPile = _mm256_sub_epi32(_mm256_setzero_si256(), fromPile);
+        __m256i stockAt = _mm256_add_epi32(rows,
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(stockCount + k))));
+        __m256i pileAt = _mm256_add_epi32(rows,
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(pileCount + k))));
+        __m256i cards = _mm256_i32gather_epi32(reinterpret_cast<const int*>(stock), stockAt, 1);
+        cards = _mm256_mask_i32gather_epi32(cards, reinterpret_cast<const int*>(pile), pileAt, fromPile, 1);
+        cards = _mm256_shuffle_epi8(_mm256_and_si256(cards, byteMask), packOrder);
+        uint32_t low = static_cast<uint32_t>(_mm256_extract_epi32(cards, 0));
+        uint32_t high = static_cast<uint32_t>(_mm256_extract_epi32(cards, 4));
+        uint64_t packed = low | static_cast<uint64_t>(high) << 32;
+        memcpy(drawn + k, &packed, sizeof(packed));
+    }
+#endif
+    for (; k < games; ++k) {
+        uint8_t fromStock = stock[k * NUM_CARDS + stockCount[k]];
+        uint8_t fromPile = pile[k * NUM_CARDS + pileCount[k]];
+        drawn[k] = take[k] ? fromPile : fromStock;
+    }
+}
+
+// Implementacija funkcije addDrawn
+// Dodaje izvučenu kartu u ruku mjesta seat u igrama u kojima je to mjesto na potezu (maskirani OR)
+void addDrawn(CardMask* seatHands, const uint8_t* drawn, const uint8_t* current, const uint8_t* active,
+    size_t seat, size_t games) {
+    size_t k = 0;
+#ifdef __AVX2__
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i seatLanes = _mm256_set1_epi64x(static_cast<long long>(seat));
+    for (; k + 4 <= games; k += 4) {
+        uint32_t drawnWord;
+        uint32_t currentWord;
+        uint32_t activeWord;
+        memcpy(&drawnWord, drawn + k, sizeof(drawnWord));
+        memcpy(&currentWord, current + k, sizeof(currentWord));
+        memcpy(&activeWord, active + k, sizeof(activeWord));
+        __m256i bits = _mm256_sllv_epi64(one, _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(static_cast<int>(drawnWord))));
+        __m256i mover = _mm256_cmpeq_epi64(_mm256_cvtepu8_epi64(_mm_cvtsi32_si128(static_cast<int>(currentWord))),
+            seatLanes);
+        __m256i live = _mm256_sub_epi64(_mm256_setzero_si256(),
+            _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(static_cast<int>(activeWord))));
+        __m256i* lanes = reinterpret_cast<__m256i*>(seatHands + k);
+        __m256i add = _mm256_and_si256(bits, _mm256_and_si256(mover, live));
+        _mm256_storeu_si256(lanes, _mm256_or_si256(_mm256_loadu_si256(lanes), add));
+    }
+#endif
+    for (; k < games; ++k) {
+        CardMask mover = static_cast<CardMask>(0) - static_cast<CardMask>(active[k] & (current[k] == seat));
+        seatHands[k] |= cardBit(drawn[k]) & mover;
+    }
+}
+
+// Implementacija funkcije updateActive
+// Igra ostaje aktivna dok nitko nije izašao i špil nije prazan (RummyGame::isGameOver)
+void updateActive(uint8_t* active, const uint8_t* stockCount, const uint8_t* wentOut, size_t games) {
+    size_t k = 0;
+#ifdef __SSE2__
+    for (; k + 16 <= games; k += 16) {
+        __m128i* lanes = reinterpret_cast<__m128i*>(active + k);
+        __m128i empty = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(stockCount + k)),
+            _mm_setzero_si128());
+        __m128i out = _mm_loadu_si128(reinterpret_cast<const __m128i*>(wentOut + k));
+        _mm_storeu_si128(lanes, _mm_andnot_si128(empty, _mm_andnot_si128(out, _mm_loadu_si128(lanes))));
+    }
+#endif
+    for (; k < games; ++k) {
+        active[k] = static_cast<uint8_t>(active[k] & (stockCount[k] != 0) & (wentOut[k] ^ 1));
+    }
+}
+
+}
+
+// Implementacija konstruktora klase GameBatch s istim evaluatorom za sva mjesta
+GameBatch::GameBatch(size_t numPlayers, const unsigned* seeds, size_t count, const Evaluator& botEvaluator,
+    DeckMode deckMode, RuleVariant variant)
+    : GameBatch(numPlayers, seeds, count, vector<const Evaluator*>(numPlayers, &botEvaluator), deckMode, variant) {
+}
+
+// Implementacija konstruktora klase GameBatch (dijeljenje kao RummyGame::dealInitialHands)
+GameBatch::GameBatch(size_t numPlayers, const unsigned* seeds, size_t count,
+    const vector<const Evaluator*>& seatEvaluators, DeckMode deckMode, RuleVariant variant)
+    : players(numPlayers), games(supportsPlayers(numPlayers, variant) ? count : 0), evaluators(seatEvaluators),
+    variant(variant), deckMode(deckMode), stockPolicy(END_ON_EMPTY_STOCK), recycleLimit(0),
+    hands(players * games, 0), stock(games * NUM_CARDS + GATHER_PADDING), stockCount(games),
+    pile(games * NUM_CARDS + GATHER_PADDING), pileCount(games, 0), discarded(games, 0), current(games, 0), active(games, 1),
+    wentOut(games, 0), scores(players * games, 0), turnTotal(0), deckRngs(games), recycles(games, 0),
+    evalHands(games), evalPiles(games), evalCandidates(games), evalValues(games), evalBestValues(games),
+    evalBest(games), evalOffset(games), takeDiscard(games), thrownCard(games), drawnCard(games) {
+    assert(supportsPlayers(numPlayers, variant) && seatEvaluators.size() == numPlayers);
+    int handSize = ruleSet(variant).handSize;
+    for (size_t k = 0; k < games; ++k) {
+        Deck deck(seeds[k], deckMode);
+        deck.materialize();
+        deckRngs[k] = deck.generator();
+        const vector<Card>& cards = deck.remaining();
+        for (size_t i = 0; i < cards.size(); ++i) {
+            stock[k * NUM_CARDS + i] = static_cast<uint8_t>(cardIndex(cards[i]));
+        }
+
+        size_t remaining = cards.size();
+        for (size_t p = 0; p < players; ++p) {
+            for (int i = 0; i < handSize && remaining > 0; ++i) {
+                hands[p * games + k] |= cardBit(stock[k * NUM_CARDS + --remaining]);
+            }
+        }
+        stockCount[k] = static_cast<uint8_t>(remaining);
+        active[k] = remaining > 0;
+    }
+}
+
+// Implementacija funkcije step (jedan potez u svakoj nedovršenoj igri)
+void GameBatch::step() {
+    turnTotal += activeCount();
+    withRules(variant, [this](auto rules) {
+        stepWith<decltype(rules)>();
+    });
+}
+
+// Implementacija funkcije stepWith (granica kucanja je konstanta prevođenja)
+template <typename Rules>
+void GameBatch::stepWith() {
+    // Faza 1: trenutne ruke svih igara s nepraznom hrpom i iste ruke s gornjom kartom procjenjuju se
+    // skupnim pozivima; najbolja odbacivanja računaju se po trakama (Evaluator::bestDiscardBatch)
+    // Igre se skupljaju po mjestu igrača na potezu jer svako mjesto ima svoj evaluator
+    for (size_t k = 0; k < games; ++k) {
+        evalOffset[k] = NO_OFFSET;
+    }
+    size_t n = 0;
+    for (size_t seat = 0; seat < players; ++seat) {
+        size_t first = n;
+        for (size_t k = 0; k < games; ++k) {
+            if (active[k] && current[k] == seat && pileCount[k] > 0) {
+                evalOffset[k] = static_cast<uint32_t>(n);
+                evalHands[n] = hands[seat * games + k];
+                evalPiles[n] = discarded[k];
+                evalCandidates[n] = evalHands[n] | cardBit(pile[k * NUM_CARDS + pileCount[k] - 1]);
+                ++n;
+            }
+        }
+        const Evaluator& evaluator = *evaluators[seat];
+        evaluator.evaluateBatch(&evalHands[first], &evalPiles[first], n - first, &evalValues[first]);
+        evaluator.bestDiscardBatch(&evalCandidates[first], &evalPiles[first], n - first, &evalBest[first],
+            &evalBestValues[first]);
+    }
+
+    // Gornja karta se uzima ako najbolje odbacivanje nakon nje nadmašuje trenutnu ruku
+    for (size_t k = 0; k < games; ++k) {
+        takeDiscard[k] = 0;
+        if (evalOffset[k] == NO_OFFSET) {
+            continue;
+        }
+        uint32_t i = evalOffset[k];
+        int top = pile[k * NUM_CARDS + pileCount[k] - 1];
+        if (evalBest[i] != top && evalBestValues[i] > evalValues[i]) {
+            takeDiscard[k] = 1;
+            thrownCard[k] = static_cast<uint8_t>(evalBest[i]);
+        }
+    }
+
+    // Faza 2: vučenje s hrpe ili iz špila po trakama, bez grananja; igre koje vuku iz špila biraju
+    // odbacivanje jednim skupnim pozivom
+    drawCounts(active.data(), takeDiscard.data(), stockCount.data(), pileCount.data(), games);
+    drawnCards(takeDiscard.data(), stock.data(), stockCount.data(), pile.data(), pileCount.data(), drawnCard.data(),
+        games);
+    for (size_t seat = 0; seat < players; ++seat) {
+        addDrawn(&hands[seat * games], drawnCard.data(), current.data(), active.data(), seat, games);
+    }
+    for (size_t k = 0; k < games; ++k) {
+        evalOffset[k] = NO_OFFSET;
+    }
+    n = 0;
+    for (size_t seat = 0; seat < players; ++seat) {
+        size_t first = n;
+        for (size_t k = 0; k < games; ++k) {
+            if (active[k] && current[k] == seat && !takeDiscard[k]) {
+                evalOffset[k] = static_cast<uint32_t>(n);
+                evalCandidates[n] = hands[seat * games + k];
+                evalPiles[n] = discarded[k];
+                ++n;
+            }
+        }
+        evaluators[seat]->bestDiscardBatch(&evalCandidates[first], &evalPiles[first], n - first, &evalBest[first],
+            &evalBestValues[first]);
+    }
+
+    // Faza 3: odbacivanje, provjera izlaska i prelazak na sljedećeg igrača
+    for (size_t k = 0; k < games; ++k) {
+        if (!active[k]) {
+            continue;
+        }
+        if (evalOffset[k] != NO_OFFSET) {
+            thrownCard[k] = static_cast<uint8_t>(evalBest[evalOffset[k]]);
+        }
+        CardMask& handRef = hands[current[k] * games + k];
+        if (!traces.empty()) {
+            traces[k].push_back(makeTraceEvent(drawnCard[k], takeDiscard[k] != 0, thrownCard[k]));
+        }
+        handRef &= ~cardBit(thrownCard[k]);
+        pile[k * NUM_CARDS + pileCount[k]++] = thrownCard[k];
+        discarded[k] |= cardBit(thrownCard[k]);
+        wentOut[k] = static_cast<uint8_t>(canGoOut<Rules>(handRef));
+        current[k] = static_cast<uint8_t>((current[k] + 1) % players);
+    }
+
+    // Prazan špil puni se s hrpe prije provjere kraja igre, kao RummyGame::replenishStock u advanceTurn
+    if (stockPolicy == RECYCLE_DISCARDS) {
+        for (size_t k = 0; k < games; ++k) {
+            if (active[k] && !wentOut[k] && stockCount[k] == 0 && recycles[k] < recycleLimit && pileCount[k] >= 2) {
+                recycleStock(k);
+            }
+        }
+    }
+
+    // Igra završava kad igrač izađe ili se špil isprazni
+    updateActive(active.data(), stockCount.data(), wentOut.data(), games);
+}
+
+// Implementacija funkcije recycleStock
+// Karte hrpe osim gornje, od dna prema vrhu, postaju špil i miješaju se nastavkom generatora igre
+// (Deck::refill). Odgođeni špil (LAZY) troši još jedan broj generatora na vučenje zadnje karte
+// (below(1)), koji unaprijed izmiješan špil preskače.
+void GameBatch::recycleStock(size_t game) {
+    uint8_t* cards = &stock[game * NUM_CARDS];
+    uint8_t* discards = &pile[game * NUM_CARDS];
+    size_t count = pileCount[game] - 1u;
+    memcpy(cards, discards, count);
+    FastRng& rng = deckRngs[game];
+    if (deckMode == LAZY) {
+        rng.next();
+    }
+    for (size_t i = count; i > 1; --i) {
+        swap(cards[i - 1], cards[rng.below(static_cast<uint32_t>(i))]);
+    }
+    discards[0] = discards[count];
+    pileCount[game] = 1;
+    stockCount[game] = static_cast<uint8_t>(count);
+    ++recycles[game];
+}
+
+// Implementacija funkcije run
+void GameBatch::run() {
+    while (!finished()) {
+        step();
+    }
+    scoreAll();
+}
+
+// Implementacija funkcije scoreWith
+// Prvi prolaz zbraja kazne svih ruku preko maski rangova bez grananja pa se vektorizira; igre u kojima
+// je netko izašao zatim se boduju obračunom s dodavanjem na meldove (scoreShowdown, kao RummyGame)
+template <typename Rules>
+void GameBatch::scoreWith() {
+    CardMask ranks[NUM_RANKS];
+    for (int r = 0; r < NUM_RANKS; ++r) {
+        ranks[r] = rankMask(r);
+    }
+    const CardMask* scored = hands.data();
+    int* out = scores.data();
+    for (size_t i = 0; i < players * games; ++i) {
+        int total = 0;
+        for (int r = 0; r < NUM_RANKS; ++r) {
+            total += Rules::penalty(r) * popCount(scored[i] & ranks[r]);
+        }
+        out[i] = total;
+    }
+
+    CardMask gameHands[MAX_PLAYERS];
+    int gameScores[MAX_PLAYERS];
+    for (size_t k = 0; k < games; ++k) {
+        if (!wentOut[k]) {
+            continue;
+        }
+        for (size_t p = 0; p < players; ++p) {
+            gameHands[p] = hands[p * games + k];
+        }
+        // Mjesto na potezu već je pomaknuto na sljedećeg igrača
+        scoreShowdown(gameHands, players, (current[k] + players - 1) % players, Rules::variant, gameScores);
+        for (size_t p = 0; p < players; ++p) {
+            out[p * games + k] = gameScores[p];
+        }
+    }
+}
+
+// Implementacija funkcije scoreAll (varijanta pravila bira se jednom, izvan petlje)
+void GameBatch::scoreAll() {
+    withRules(variant, [this](auto rules) {
+        scoreWith<decltype(rules)>();
+    });
+}
+
+// Implementacija funkcije supportsPlayers
+bool GameBatch::supportsPlayers(size_t numPlayers, RuleVariant variant) {
+    return numPlayers <= MAX_PLAYERS && supportsPlayerCount(ruleSet(variant), numPlayers);
+}
+
+// Implementacija funkcije finished
+bool GameBatch::finished() const {
+    return activeCount() == 0;
+}
+
+// Implementacija funkcije size
+size_t GameBatch::size() const {
+    return games;
+}
+
+// Implementacija funkcije activeCount
+size_t GameBatch::activeCount() const {
+    size_t count = 0;
+    size_t k = 0;
+#ifdef __SSE2__
+    // Zbroj 16 bajtova po koraku (psadbw daje dva djelomična zbroja)
+    __m128i sums = _mm_setzero_si128();
+    for (; k + 16 <= games; k += 16) {
+        __m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&active[k]));
+        sums = _mm_add_epi64(sums, _mm_sad_epu8(lanes, _mm_setzero_si128()));
+    }
+    count = static_cast<size_t>(_mm_cvtsi128_si32(sums)) + static_cast<size_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+#endif
+    for (; k < games; ++k) {
+        count += active[k];
+    }
+    return count;
+}
+
+// Implementacija funkcije turns (zbroj odigranih poteza svih igara)
+uint64_t GameBatch::turns() const {
+    return turnTotal;
+}
+
+// Implementacija funkcije score
+int GameBatch::score(size_t game, size_t player) const {
+    return scores[player * games + game];
+}
+
+// Implementacija funkcije hand
+CardMask GameBatch::hand(size_t game, size_t player) const {
+    return hands[player * games + game];
+}
+
+// Implementacija funkcije settle (nakon run; out prima size() zapisa)
+void GameBatch::settle(Settlement* out) const {
+    settleBatch(scores.data(), players, games, out);
+}
+
+// Implementacija funkcije enableTraces (poziva se prije prvog poteza)
+void GameBatch::enableTraces() {
+    traces.assign(games, vector<TraceEvent>());
+    for (auto& events : traces) {
+        events.reserve(2 * NUM_CARDS);
+    }
+}
+
+// Implementacija funkcije setStockPolicy
+void GameBatch::setStockPolicy(StockPolicy policy, size_t maxRecycles) {
+    stockPolicy = policy;
+    recycleLimit = maxRecycles;
+}
+
+// Implementacija funkcije recycleCount (zbroj punjenja špila svih igara)
+uint64_t GameBatch::recycleCount() const {
+    uint64_t total = 0;
+    for (uint32_t count : recycles) {
+        total += count;
+    }
+    return total;
+}
+
+// Implementacija funkcije cardsConserved (kao RummyGame::cardsConserved)
+bool GameBatch::cardsConserved(size_t game) const {
+    CardMask seen = 0;
+    size_t count = 0;
+    for (size_t p = 0; p < players; ++p) {
+        seen |= hands[p * games + game];
+        count += static_cast<size_t>(popCount(hands[p * games + game]));
+    }
+    for (size_t i = 0; i < stockCount[game]; ++i) {
+        seen |= cardBit(stock[game * NUM_CARDS + i]);
+    }
+    for (size_t i = 0; i < pileCount[game]; ++i) {
+        seen |= cardBit(pile[game * NUM_CARDS + i]);
+    }
+    count += stockCount[game] + pileCount[game];
+    return seen == FULL_DECK_MASK && count == static_cast<size_t>(NUM_CARDS);
+}
+
+// Implementacija funkcije trace
+const vector<TraceEvent>& GameBatch::trace(size_t game) const {
+    return traces[game];
+}
@@ -0,0 +1,95 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "cardmask.h"
+#include "evaluator.h"
+#include "rules.h"
+#include "rummy.h"
+#include "settlement.h"
+#include "trace.h"
+#include <cstdint>
+#include <vector>
+
+// K igara u rasporedu "struktura nizova": ruke, špilovi, hrpe i bodovi svake igre
+// leže u zasebnim uzastopnim nizovima. Sve igre napreduju istovremeno, potez po potez,
+// a odluke botova računaju se skupnim pozivima evaluatora, jednim po mjestu za stolom.
+// Rezultat je bit po bit jednak RummyGame::simulate za ista sjemena.
+class GameBatch {
+public:
+    static const size_t MAX_PLAYERS = 4;
+
+    // Broj igrača izvan 2..MAX_PLAYERS ili prevelik za podjelu varijante (supportsPlayerCount)
+    // odbija se: pozivatelj ga provjerava prije konstrukcije, a takav batch nema igara (size() == 0)
+    static bool supportsPlayers(size_t numPlayers, RuleVariant variant = GIN_RUMMY);
+
+    GameBatch(size_t numPlayers, const unsigned* seeds, size_t count, const Evaluator& botEvaluator,
+        DeckMode deckMode = SHUFFLED, RuleVariant variant = GIN_RUMMY);
+    // Zaseban evaluator za svako mjesto (dvoboj botova); seatEvaluators ima numPlayers elemenata
+    GameBatch(size_t numPlayers, const unsigned* seeds, size_t count,
+        const std::vector<const Evaluator*>& seatEvaluators, DeckMode deckMode = SHUFFLED, RuleVariant variant = GIN_RUMMY);
+    void step();
+    void run();
+    bool finished() const;
+    size_t size() const;
+    size_t activeCount() const;
+    uint64_t turns() const;
+    int score(size_t game, size_t player) const;
+    CardMask hand(size_t game, size_t player) const;
+    void settle(Settlement* out) const;
+    void enableTraces();
+    const std::vector<TraceEvent>& trace(size_t game) const;
+    // Punjenje praznog špila s hrpe kao RummyGame::setStockPolicy; poziva se prije prvog poteza
+    void setStockPolicy(StockPolicy policy, size_t maxRecycles);
+    uint64_t recycleCount() const;
+    bool cardsConserved(size_t game) const;
+
+private:
+    size_t players;
+    size_t games;
+    std::vector<const Evaluator*> evaluators;
+    RuleVariant variant;
+    DeckMode deckMode;
+    StockPolicy stockPolicy;
+    size_t recycleLimit;
+
+    // Indeksiranje: [igrač * games + igra] za ruke i bodove, [igra * NUM_CARDS + i] za špil i hrpu
+    std::vector<CardMask> hands;
+    std::vector<uint8_t> stock;
+    std::vector<uint8_t> stockCount;
+    std::vector<uint8_t> pile;
+    std::vector<uint8_t> pileCount;
+    std::vector<CardMask> discarded;
+    std::vector<uint8_t> current;
+    std::vector<uint8_t> active;
+    std::vector<uint8_t> wentOut;
+    std::vector<int> scores;
+    uint64_t turnTotal;
+
+    // Generator špila svake igre nastavlja se kod punjenja (Deck::refill) i broj punjenja po igri
+    std::vector<FastRng> deckRngs;
+    std::vector<uint32_t> recycles;
+
+    // Unaprijed alocirani spremnici za skupnu procjenu
+    std::vector<CardMask> evalHands;
+    std::vector<CardMask> evalPiles;
+    std::vector<CardMask> evalCandidates;
+    std::vector<float> evalValues;
+    std::vector<float> evalBestValues;
+    std::vector<int> evalBest;
+    std::vector<uint32_t> evalOffset;
+    std::vector<uint8_t> takeDiscard;
+    std::vector<uint8_t> thrownCard;
+    std::vector<uint8_t> drawnCard;
+
+    // Zapisi poteza po igri; prazno ako zapisivanje nije uključeno
+    std::vector<std::vector<TraceEvent>> traces;
+
+    template <typename Rules>
+    void stepWith();
+    void recycleStock(size_t game);
+    void scoreAll();
+    template <typename Rules>
+    void scoreWith();
+};
+
+#endif
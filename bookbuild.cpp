@@ -0,0 +1,149 @@
+#include "rummy.h"
+#include "canonical.h"
+#include "openingbook.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Izrada knjige otvaranja: za ruke od 11 karata nakon prvog vučenja iz zadanih dijeljenja
+// traži se odbacivanje s najboljom očekivanom procjenom nakon sljedećeg vučenja.
+// Ruke se svode na kanonske boje pa jedan zapis pokriva sve permutacije boja.
+
+namespace {
+
+void printUsage() {
+    cout << "Usage: rummy_bookbuild [-n deals] [-s firstSeed] [-p players] [-t threads] [-w weights] [-o output]\n";
+}
+
+// Dvoslojna procjena: za svako odbacivanje prosjek, po svim neviđenim kartama,
+// najbolje procjene nakon vučenja te karte i ponovnog odbacivanja
+int solveDiscard(const Evaluator& evaluator, CardMask hand) {
+    CardMask unseen = FULL_DECK_MASK & ~hand;
+    int unseenCount = popCount(unseen);
+
+    int best = -1;
+    float bestValue = 0.0f;
+    for (CardMask candidates = hand; candidates; candidates &= candidates - 1) {
+        int discard = lowestCard(candidates);
+        CardMask kept = hand & ~cardBit(discard);
+        CardMask discards = cardBit(discard);
+
+        float total = 0.0f;
+        for (CardMask draws = unseen; draws; draws &= draws - 1) {
+            float value = 0.0f;
+            evaluator.bestDiscard(kept | cardBit(lowestCard(draws)), discards, value);
+            total += value;
+        }
+        float value = total / static_cast<float>(unseenCount);
+        if (best < 0 || value > bestValue) {
+            best = discard;
+            bestValue = value;
+        }
+    }
+    return best;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    size_t dealCount = 100000;
+    unsigned firstSeed = 1;
+    size_t numPlayers = 2;
+    size_t threadCount = 0;
+    string weights;
+    string output = "rummy_book.bin";
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc) {
+            dealCount = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-s" && i + 1 < argc) {
+            firstSeed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-p" && i + 1 < argc) {
+            numPlayers = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-t" && i + 1 < argc) {
+            threadCount = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-w" && i + 1 < argc) {
+            weights = argv[++i];
+        }
+        else if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (numPlayers < 2 || numPlayers > GameState::MAX_PLAYERS) {
+        printUsage();
+        return 1;
+    }
+    if (threadCount == 0) {
+        threadCount = thread::hardware_concurrency() ? thread::hardware_concurrency() : 1;
+    }
+
+    Evaluator evaluator;
+    if (!weights.empty() && !evaluator.loadWeights(weights)) {
+        cerr << "Error: cannot load weights from " << weights << "\n";
+        return 1;
+    }
+
+    // Dijeljenja se dijele dretvama preko atomskog brojača, svaka dretva puni svoj niz zapisa
+    auto start = chrono::steady_clock::now();
+    vector<vector<OpeningBook::Entry>> results(threadCount);
+    atomic<size_t> next(0);
+    auto worker = [&](size_t t) {
+        for (size_t i = next++; i < dealCount; i = next++) {
+            GameState state = RummyGame(numPlayers, firstSeed + static_cast<unsigned>(i), evaluator).toState();
+            for (uint8_t seat = 0; seat < state.numPlayers && seat < state.stockCount; ++seat) {
+                // Prvi potez: igrač vuče iz špila, prije njega su vukli samo igrači s manjim indeksom
+                CardMask hand = state.hands[seat] | cardBit(state.stock[state.stockCount - 1 - seat]);
+                CardMask canonical = canonicalHand(hand, nullptr);
+                int discard = solveDiscard(evaluator, canonical);
+                results[t].push_back({ canonical, static_cast<uint8_t>(discard) });
+            }
+        }
+    };
+
+    vector<thread> threads;
+    for (size_t t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // Poredak zapisa ne ovisi o rasporedu dretvi pa je datoteka ista za svaki broj dretvi
+    vector<OpeningBook::Entry> entries;
+    for (const auto& result : results) {
+        entries.insert(entries.end(), result.begin(), result.end());
+    }
+    sort(entries.begin(), entries.end(), [](const OpeningBook::Entry& a, const OpeningBook::Entry& b) {
+        return a.hand < b.hand;
+    });
+    entries.erase(unique(entries.begin(), entries.end(), [](const OpeningBook::Entry& a, const OpeningBook::Entry& b) {
+        return a.hand == b.hand;
+    }), entries.end());
+
+    if (!OpeningBook::write(output, entries)) {
+        cerr << "Error: cannot write " << output << "\n";
+        return 1;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "positions " << entries.size() << " from " << dealCount << " deals\n"
+        << "time " << seconds << " s (" << threadCount << " threads)\n"
+        << "written " << output << "\n";
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "canonical.h"
+#include <utility>
+
+using namespace std;
+
+namespace {
+
+// Mreža za sortiranje četiri vrijednosti (pet usporedbi)
+template <typename T>
+void sortFour(T* values) {
+    if (values[1] < values[0]) swap(values[0], values[1]);
+    if (values[3] < values[2]) swap(values[2], values[3]);
+    if (values[2] < values[0]) swap(values[0], values[2]);
+    if (values[3] < values[1]) swap(values[1], values[3]);
+    if (values[2] < values[1]) swap(values[1], values[2]);
+}
+
+}
+
+// Implementacija funkcije permuteMask
+CardMask permuteMask(CardMask mask, const uint8_t* perm) {
+    CardMask result = 0;
+    for (int suit = 0; suit < NUM_SUITS; ++suit) {
+        CardMask row = (mask >> (suit * NUM_RANKS)) & SUIT_ROW_MASK;
+        result |= row << (perm[suit] * NUM_RANKS);
+    }
+    return result;
+}
+
+// Implementacija funkcije canonicalHand
+CardMask canonicalHand(CardMask hand, uint8_t* perm) {
+    // Ključ za sortiranje: redak boje u gornjim bitovima, boja u donjim (jednaki reci ostaju stabilni)
+    uint32_t keys[NUM_SUITS];
+    for (int suit = 0; suit < NUM_SUITS; ++suit) {
+        uint32_t row = static_cast<uint32_t>((hand >> (suit * NUM_RANKS)) & SUIT_ROW_MASK);
+        keys[suit] = ((static_cast<uint32_t>(SUIT_ROW_MASK) - row) << 2) | static_cast<uint32_t>(suit);
+    }
+    sortFour(keys);
+
+    CardMask result = 0;
+    for (int position = 0; position < NUM_SUITS; ++position) {
+        int suit = keys[position] & 3;
+        result |= ((hand >> (suit * NUM_RANKS)) & SUIT_ROW_MASK) << (position * NUM_RANKS);
+        if (perm) {
+            perm[suit] = static_cast<uint8_t>(position);
+        }
+    }
+    return result;
+}
+
+// Implementacija funkcije canonicalHandHash
+uint64_t canonicalHandHash(CardMask hand) {
+    return mix64(canonicalHand(hand, nullptr));
+}
+
+// Implementacija funkcije computeSuitKeys
+void computeSuitKeys(const GameState& state, uint64_t* suitKeys) {
+    for (int suit = 0; suit < NUM_SUITS; ++suit) {
+        suitKeys[suit] = 0;
+    }
+    for (uint8_t player = 0; player < state.numPlayers; ++player) {
+        for (CardMask bits = state.hands[player]; bits; bits &= bits - 1) {
+            toggleCardKey(suitKeys, ZOBRIST_HAND, player, lowestCard(bits));
+        }
+    }
+    for (uint8_t i = 0; i < state.stockCount; ++i) {
+        toggleCardKey(suitKeys, ZOBRIST_STOCK, i, state.stock[i]);
+    }
+    for (uint8_t i = 0; i < state.discardCount; ++i) {
+        toggleCardKey(suitKeys, ZOBRIST_DISCARD, i, state.discards[i]);
+    }
+    if (state.takenDiscard != GameState::NO_CARD) {
+        toggleCardKey(suitKeys, ZOBRIST_TAKEN, 0, state.takenDiscard);
+    }
+    for (uint8_t i = 0; i < state.meldCount; ++i) {
+        toggleMeldKeys(suitKeys, state.melds[i], state.meldOwner[i]);
+    }
+}
+
+// Implementacija funkcije canonicalStateHash
+uint64_t canonicalStateHash(const GameState& state) {
+    uint64_t keys[NUM_SUITS] = { state.suitKeys[0], state.suitKeys[1], state.suitKeys[2], state.suitKeys[3] };
+    sortFour(keys);
+
+    uint64_t hash = mix64(state.current | (static_cast<uint64_t>(state.phase) << 8) |
+        (static_cast<uint64_t>(state.stockCount) << 16) | (static_cast<uint64_t>(state.discardCount) << 24) |
+        (static_cast<uint64_t>(state.numPlayers) << 32) | (static_cast<uint64_t>(state.meldCount) << 40));
+    for (int i = 0; i < NUM_SUITS; ++i) {
+        hash = mix64(hash ^ keys[i]);
+    }
+    return hash;
+}
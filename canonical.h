@@ -0,0 +1,64 @@
+#ifndef CANONICAL_H
+#define CANONICAL_H
+
+#include "cardmask.h"
+#include "gamestate.h"
+#include <cstdint>
+
+// Kanonski oblik i hashiranje stanja s obzirom na simetriju boja.
+// Zamjena boja (24 permutacije) ne mijenja igru, pa se pozicije koje se razlikuju samo
+// u bojama svode na isti ključ. Zobrist ključevi ne ovise o boji: svaka boja ima svoj
+// zbroj (XOR) ključeva po rangu, a kanonski hash kombinira ta četiri zbroja nakon sortiranja.
+// Sortiranje četiri vrijednosti zamjenjuje isprobavanje svih 24 permutacija.
+
+inline uint64_t mix64(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+// Vrste Zobrist ključeva; ključ ovisi o vrsti, položaju (igrač ili mjesto u nizu) i rangu
+enum ZobristTag : uint64_t { ZOBRIST_HAND = 1, ZOBRIST_STOCK, ZOBRIST_DISCARD, ZOBRIST_TAKEN, ZOBRIST_TABLE };
+
+inline uint64_t zobristKey(ZobristTag tag, int position, int value) {
+    return mix64((static_cast<uint64_t>(tag) << 48) ^ (static_cast<uint64_t>(position) << 24) ^
+        static_cast<uint64_t>(value) ^ 0x9e3779b97f4a7c15ULL);
+}
+
+// Ključ karte dodaje se u zbroj njezine boje
+inline void toggleCardKey(uint64_t* suitKeys, ZobristTag tag, int position, int card) {
+    suitKeys[card / NUM_RANKS] ^= zobristKey(tag, position, card % NUM_RANKS);
+}
+
+// Meld na stolu: za svaku boju ključ retka tog melda. Niz je uvijek u jednoj boji, a set ima
+// jednu kartu po boji i najviše jedan set po rangu, pa reci jednoznačno određuju podjelu na meldove.
+inline void toggleMeldRowKey(uint64_t* suitKeys, CardMask meld, int owner, int suit) {
+    CardMask row = (meld >> (suit * NUM_RANKS)) & SUIT_ROW_MASK;
+    if (row) {
+        suitKeys[suit] ^= zobristKey(ZOBRIST_TABLE, owner, static_cast<int>(row));
+    }
+}
+
+inline void toggleMeldKeys(uint64_t* suitKeys, CardMask meld, int owner) {
+    for (int suit = 0; suit < NUM_SUITS; ++suit) {
+        toggleMeldRowKey(suitKeys, meld, owner, suit);
+    }
+}
+
+// Preslikavanje boja: karta boje s prelazi u boju perm[s]
+CardMask permuteMask(CardMask mask, const uint8_t* perm);
+
+// Kanonska ruka: reci boja poredani silazno; perm (ako nije nullptr) prima korištenu permutaciju
+CardMask canonicalHand(CardMask hand, uint8_t* perm);
+uint64_t canonicalHandHash(CardMask hand);
+
+// Puni izračun zbrojeva po bojama (makeMove/unmakeMove ih održavaju inkrementalno)
+void computeSuitKeys(const GameState& state, uint64_t* suitKeys);
+
+// Hash stanja neovisan o permutaciji boja
+uint64_t canonicalStateHash(const GameState& state);
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef CARD_H
+#define CARD_H
+
+#include <iostream>
+
+enum Suit { HEARTS, DIAMONDS, CLUBS, SPADES };
+enum Rank { ACE = 1, TWO, THREE, FOUR, FIVE, SIX, SEVEN, EIGHT, NINE, TEN, JACK, QUEEN, KING };
+
+struct Card {
+    Suit suit;
+    Rank rank;
+
+    bool operator==(const Card& other) const {
+        return suit == other.suit && rank == other.rank;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Card& card);
+};
+
+std::ostream& operator<<(std::ostream& os, const Suit& suit);
+std::ostream& operator<<(std::ostream& os, const Rank& rank);
+
+#endif
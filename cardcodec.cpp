@@ -0,0 +1,205 @@
+#include "cardcodec.h"
+#include <cstring>
+
+using namespace std;
+
+namespace {
+
+const char SUIT_SYMBOLS[NUM_SUITS + 1] = "HDCS";
+const char RANK_SYMBOLS[NUM_RANKS + 1] = "A23456789TJQK";
+
+// Tablice za dekodiranje znaka u indeks boje/ranga, -1 za nepoznate znakove
+struct DecodeTables {
+    int8_t suit[256];
+    int8_t rank[256];
+
+    DecodeTables() {
+        memset(suit, -1, sizeof(suit));
+        memset(rank, -1, sizeof(rank));
+        for (int i = 0; i < NUM_SUITS; ++i) {
+            suit[static_cast<unsigned char>(SUIT_SYMBOLS[i])] = static_cast<int8_t>(i);
+            suit[static_cast<unsigned char>(SUIT_SYMBOLS[i] + ('a' - 'A'))] = static_cast<int8_t>(i);
+        }
+        for (int i = 0; i < NUM_RANKS; ++i) {
+            rank[static_cast<unsigned char>(RANK_SYMBOLS[i])] = static_cast<int8_t>(i);
+            if (RANK_SYMBOLS[i] >= 'A') {
+                rank[static_cast<unsigned char>(RANK_SYMBOLS[i] + ('a' - 'A'))] = static_cast<int8_t>(i);
+            }
+        }
+    }
+};
+
+const DecodeTables DECODE;
+
+bool isSeparator(char c) {
+    return c == ' ' || c == ',' || c == '\t' || c == '\n' || c == '\r';
+}
+
+}
+
+// Implementacija funkcije getSuitSymbol
+char getSuitSymbol(Suit suit) {
+    unsigned index = static_cast<unsigned>(suit);
+    return index < static_cast<unsigned>(NUM_SUITS) ? SUIT_SYMBOLS[index] : '?';
+}
+
+// Implementacija funkcije getRankSymbol
+char getRankSymbol(Rank rank) {
+    unsigned index = static_cast<unsigned>(rank) - 1;
+    return index < static_cast<unsigned>(NUM_RANKS) ? RANK_SYMBOLS[index] : '?';
+}
+
+// Implementacija funkcije decodeCard
+int decodeCard(char rank, char suit) {
+    int r = DECODE.rank[static_cast<unsigned char>(rank)];
+    int s = DECODE.suit[static_cast<unsigned char>(suit)];
+    return (r < 0 || s < 0) ? -1 : s * NUM_RANKS + r;
+}
+
+// Implementacija funkcije parseCard
+bool parseCard(const string& text, Card& card) {
+    if (text.size() != 2) {
+        return false;
+    }
+    int index = decodeCard(text[0], text[1]);
+    if (index < 0) {
+        return false;
+    }
+    card = cardFromIndex(index);
+    return true;
+}
+
+// Implementacija funkcije encodeCards (vraća broj zapisanih znakova)
+size_t encodeCards(const uint8_t* cards, size_t count, char* out) {
+    char* p = out;
+    for (size_t i = 0; i < count; ++i) {
+        if (i > 0) {
+            *p++ = ' ';
+        }
+        *p++ = RANK_SYMBOLS[cards[i] % NUM_RANKS];
+        *p++ = SUIT_SYMBOLS[cards[i] / NUM_RANKS];
+    }
+    return static_cast<size_t>(p - out);
+}
+
+// Implementacija funkcije encodeMask (karte rastućim indeksom)
+size_t encodeMask(CardMask mask, char* out) {
+    uint8_t cards[NUM_CARDS];
+    size_t count = 0;
+    for (; mask; mask &= mask - 1) {
+        cards[count++] = static_cast<uint8_t>(lowestCard(mask));
+    }
+    return encodeCards(cards, count, out);
+}
+
+// Implementacija funkcije decodeCards
+bool decodeCards(const char* text, size_t length, uint8_t* cards, size_t capacity, size_t& count) {
+    count = 0;
+    size_t i = 0;
+    while (i < length) {
+        if (isSeparator(text[i])) {
+            ++i;
+            continue;
+        }
+        if (i + 1 >= length || count == capacity) {
+            return false;
+        }
+        int index = decodeCard(text[i], text[i + 1]);
+        if (index < 0 || (i + 2 < length && !isSeparator(text[i + 2]))) {
+            return false;
+        }
+        cards[count++] = static_cast<uint8_t>(index);
+        i += 2;
+    }
+    return true;
+}
+
+// Implementacija funkcije decodeMask (ponovljena karta je greška)
+bool decodeMask(const char* text, size_t length, CardMask& mask) {
+    uint8_t cards[NUM_CARDS];
+    size_t count = 0;
+    if (!decodeCards(text, length, cards, NUM_CARDS, count)) {
+        return false;
+    }
+    mask = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (mask & cardBit(cards[i])) {
+            return false;
+        }
+        mask |= cardBit(cards[i]);
+    }
+    return true;
+}
+
+// Implementacija funkcije encodeDeal
+size_t encodeDeal(const CardMask* hands, size_t handCount, char* out) {
+    char* p = out;
+    for (size_t i = 0; i < handCount; ++i) {
+        if (i > 0) {
+            *p++ = '/';
+        }
+        p += encodeMask(hands[i], p);
+    }
+    return static_cast<size_t>(p - out);
+}
+
+// Implementacija funkcije decodeDeal (karta se ne smije pojaviti u dvije ruke)
+bool decodeDeal(const char* text, size_t length, CardMask* hands, size_t capacity, size_t& handCount) {
+    handCount = 0;
+    CardMask seen = 0;
+    size_t start = 0;
+    while (start <= length) {
+        const char* end = static_cast<const char*>(memchr(text + start, '/', length - start));
+        size_t stop = end ? static_cast<size_t>(end - text) : length;
+        if (handCount == capacity || !decodeMask(text + start, stop - start, hands[handCount]) ||
+            (seen & hands[handCount])) {
+            return false;
+        }
+        seen |= hands[handCount++];
+        start = stop + 1;
+    }
+    return true;
+}
+
+// Implementacija funkcije formatHand
+string formatHand(const vector<Card>& hand) {
+    string text(hand.empty() ? 0 : hand.size() * 3 - 1, ' ');
+    for (size_t i = 0; i < hand.size(); ++i) {
+        text[i * 3] = getRankSymbol(hand[i].rank);
+        text[i * 3 + 1] = getSuitSymbol(hand[i].suit);
+    }
+    return text;
+}
+
+// Implementacija funkcije parseHand (redoslijed karata se čuva, ponovljena karta je pogreška)
+bool parseHand(const string& text, vector<Card>& hand) {
+    uint8_t cards[NUM_CARDS];
+    size_t count = 0;
+    if (!decodeCards(text.data(), text.size(), cards, NUM_CARDS, count)) {
+        return false;
+    }
+    CardMask seen = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (seen & cardBit(cards[i])) {
+            return false;
+        }
+        seen |= cardBit(cards[i]);
+    }
+    hand.clear();
+    for (size_t i = 0; i < count; ++i) {
+        hand.push_back(cardFromIndex(cards[i]));
+    }
+    return true;
+}
+
+ostream& operator<<(ostream& os, const Card& card) {
+    return os << getRankSymbol(card.rank) << getSuitSymbol(card.suit);
+}
+
+ostream& operator<<(ostream& os, const Suit& suit) {
+    return os << getSuitSymbol(suit);
+}
+
+ostream& operator<<(ostream& os, const Rank& rank) {
+    return os << getRankSymbol(rank);
+}
@@ -0,0 +1,32 @@
+#ifndef CARDCODEC_H
+#define CARDCODEC_H
+
+#include "cardmask.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Tekstualni zapis karata: rang pa boja, npr. "TH JS 2C" (T je desetka).
+// Skupne funkcije pišu u pozivateljev spremnik i ne alociraju.
+
+char getSuitSymbol(Suit suit);
+char getRankSymbol(Rank rank);
+
+// Indeks karte (cardIndex) iz dva znaka ili -1 ako zapis nije ispravan
+int decodeCard(char rank, char suit);
+bool parseCard(const std::string& text, Card& card);
+
+// Zapisuje karte odvojene razmakom; out mora imati mjesta za 3 * count znakova
+size_t encodeCards(const uint8_t* cards, size_t count, char* out);
+size_t encodeMask(CardMask mask, char* out);
+bool decodeCards(const char* text, size_t length, uint8_t* cards, size_t capacity, size_t& count);
+bool decodeMask(const char* text, size_t length, CardMask& mask);
+
+// Podjela: ruke odvojene znakom '/', npr. "AH 2H 3H/KS QS JS"
+size_t encodeDeal(const CardMask* hands, size_t handCount, char* out);
+bool decodeDeal(const char* text, size_t length, CardMask* hands, size_t capacity, size_t& handCount);
+
+std::string formatHand(const std::vector<Card>& hand);
+bool parseHand(const std::string& text, std::vector<Card>& hand);
+
+#endif
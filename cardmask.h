@@ -0,0 +1,77 @@
+#ifndef CARDMASK_H
+#define CARDMASK_H
+
+#include "card.h"
+#include <cstdint>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Karte kao bitovi: indeks = boja * 13 + (rang - 1), svaka boja zauzima 13 uzastopnih bitova
+typedef uint64_t CardMask;
+
+const int NUM_SUITS = 4;
+const int NUM_RANKS = 13;
+const int NUM_CARDS = 52;
+
+const CardMask FULL_DECK_MASK = (1ULL << NUM_CARDS) - 1;
+const CardMask SUIT_ROW_MASK = (1ULL << NUM_RANKS) - 1;
+
+inline int cardIndex(const Card& card) {
+    return static_cast<int>(card.suit) * NUM_RANKS + (static_cast<int>(card.rank) - 1);
+}
+
+inline Card cardFromIndex(int index) {
+    return { static_cast<Suit>(index / NUM_RANKS), static_cast<Rank>(index % NUM_RANKS + 1) };
+}
+
+inline CardMask cardBit(int index) {
+    return 1ULL << index;
+}
+
+inline CardMask handMask(const std::vector<Card>& cards) {
+    CardMask mask = 0;
+    for (const auto& card : cards) {
+        mask |= cardBit(cardIndex(card));
+    }
+    return mask;
+}
+
+// Svi bitovi jednog ranga (sve četiri boje); rank je 0..12
+inline CardMask rankMask(int rank) {
+    return (1ULL << rank) | (1ULL << (rank + 13)) | (1ULL << (rank + 26)) | (1ULL << (rank + 39));
+}
+
+inline int popCount(CardMask mask) {
+#ifdef _MSC_VER
+    return static_cast<int>(__popcnt64(mask));
+#else
+    return __builtin_popcountll(mask);
+#endif
+}
+
+// Indeks najniže karte u maski; maska ne smije biti prazna
+inline int lowestCard(CardMask mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+// Indeks najviše karte u maski; maska ne smije biti prazna
+inline int highestCard(CardMask mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse64(&index, mask);
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(mask);
+#endif
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef COMBINATIONS_H
+#define COMBINATIONS_H
+
+#include "cardmask.h"
+
+// Obilazak svih t-članih podskupova od {0..n-1} Grayevim kodom "okretnih vrata"
+// (Knuth, TAOCP 7.2.1.3, algoritam R): svaki korak izbacuje jedan element i ubacuje jedan,
+// pa se vrijednosti koje ovise o ruci mogu ažurirati inkrementalno. Vrijedi za 2 <= t < n.
+class RevolvingDoor {
+public:
+    static const int MAX_T = 16;
+
+    RevolvingDoor(int n, int t) : t(t), current(0) {
+        for (int j = 1; j <= t; ++j) {
+            c[j] = j - 1;
+            current |= cardBit(j - 1);
+        }
+        // Stražar iza c[t + 1] zaustavlja R5 kad j prijeđe t
+        c[t + 1] = n;
+        c[t + 2] = n;
+    }
+
+    CardMask mask() const {
+        return current;
+    }
+
+    // Prelazi na sljedeći podskup; false kad su svi obiđeni
+    bool next(int& removed, int& added) {
+        CardMask previous = current;
+        // R3: laki slučaj mijenja samo c[1]; neparan t ga povećava, paran smanjuje
+        if (t & 1) {
+            if (c[1] + 1 < c[2]) {
+                move(1, c[1] + 1);
+                return finish(previous, removed, added);
+            }
+        }
+        else if (c[1] > 0) {
+            move(1, c[1] - 1);
+            return finish(previous, removed, added);
+        }
+
+        bool tryDecrease = (t & 1) != 0;
+        for (int j = 2;;) {
+            if (tryDecrease) {
+                // R4: pokušaj smanjiti c[j]
+                if (c[j] >= j) {
+                    move(j, c[j - 1]);
+                    move(j - 1, j - 2);
+                    return finish(previous, removed, added);
+                }
+                ++j;
+            }
+            tryDecrease = true;
+            // R5: pokušaj povećati c[j]
+            if (c[j] + 1 < c[j + 1]) {
+                move(j - 1, c[j]);
+                move(j, c[j] + 1);
+                return finish(previous, removed, added);
+            }
+            ++j;
+            if (j > t) {
+                return false;
+            }
+        }
+    }
+
+private:
+    int t;
+    int c[MAX_T + 3];
+    CardMask current;
+
+    void move(int j, int value) {
+        current ^= cardBit(c[j]) ^ cardBit(value);
+        c[j] = value;
+    }
+
+    bool finish(CardMask previous, int& removed, int& added) {
+        removed = lowestCard(previous & ~current);
+        added = lowestCard(current & ~previous);
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,145 @@
+#include "deadwood.h"
+#include <cstdint>
+
+using namespace std;
+
+namespace {
+
+const int MAX_HAND_MELDS = 96;
+
+// Zbroj vrijednosti za svaki mogući redak boje (2^13 kombinacija rangova), po varijanti
+struct RowValues {
+    uint8_t values[NUM_RULE_VARIANTS][1 << NUM_RANKS];
+
+    RowValues() {
+        for (int variant = 0; variant < NUM_RULE_VARIANTS; ++variant) {
+            for (int row = 0; row < (1 << NUM_RANKS); ++row) {
+                int total = 0;
+                for (int rank = 0; rank < NUM_RANKS; ++rank) {
+                    if (row & (1 << rank)) {
+                        total += rankPenalty(RULE_SETS[variant], rank);
+                    }
+                }
+                values[variant][row] = static_cast<uint8_t>(total);
+            }
+        }
+    }
+};
+
+const RowValues ROW_VALUES;
+
+int rowDeadwood(const uint8_t* values, CardMask cards) {
+    return values[cards & SUIT_ROW_MASK] +
+        values[(cards >> NUM_RANKS) & SUIT_ROW_MASK] +
+        values[(cards >> (2 * NUM_RANKS)) & SUIT_ROW_MASK] +
+        values[(cards >> (3 * NUM_RANKS)) & SUIT_ROW_MASK];
+}
+
+// Svi meldovi sadržani u ruci: setovi od 3 i 4 karte te svi podnizovi dulji od 2. Niz kreće od
+// svakog ranga boje i produžuje se dok karte postoje i runFits dopušta (preko asa prema pravilima).
+int collectMelds(CardMask hand, const RuleSet& rules, CardMask* melds) {
+    int count = 0;
+    for (int rank = 0; rank < NUM_RANKS; ++rank) {
+        CardMask set = hand & rankMask(rank);
+        int size = popCount(set);
+        if (size == 4) {
+            melds[count++] = set;
+            for (CardMask bits = set; bits; bits &= bits - 1) {
+                melds[count++] = set & ~(bits & (0 - bits));
+            }
+        }
+        else if (size == 3) {
+            melds[count++] = set;
+        }
+    }
+    for (int suit = 0; suit < NUM_SUITS && count < MAX_HAND_MELDS; ++suit) {
+        int base = suit * NUM_RANKS;
+        CardMask row = (hand >> base) & SUIT_ROW_MASK;
+        for (int low = 0; low < NUM_RANKS; ++low) {
+            int length = 0;
+            while (length < NUM_RANKS && (row & (1ULL << ((low + length) % NUM_RANKS))) && count < MAX_HAND_MELDS) {
+                ++length;
+                if (length >= 3) {
+                    if (!runFits(rules, low, length)) {
+                        break;
+                    }
+                    melds[count++] = runRow(low, length) << base;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+// Pretraga disjunktnih podskupova meldova; meldovi se biraju rastućim indeksom pa se svaki raspored posjećuje jednom
+void searchMelds(const uint8_t* values, const CardMask* melds, int count, int index, CardMask remaining, int& best,
+    CardMask& bestRemaining) {
+    int value = rowDeadwood(values, remaining);
+    if (value < best) {
+        best = value;
+        bestRemaining = remaining;
+    }
+    for (int i = index; i < count && best > 0; ++i) {
+        if ((melds[i] & remaining) == melds[i]) {
+            searchMelds(values, melds, count, i + 1, remaining & ~melds[i], best, bestRemaining);
+        }
+    }
+}
+
+// Pokrivanje svih karata meldovima: najniža nepokrivena karta mora biti u jednom od kandidata
+bool coverMelds(const CardMask* candidates, int count, CardMask remaining, CardMask* melds, int& used) {
+    if (remaining == 0) {
+        return true;
+    }
+    CardMask lowest = remaining & (0 - remaining);
+    for (int i = 0; i < count; ++i) {
+        if ((candidates[i] & lowest) && (candidates[i] & remaining) == candidates[i]) {
+            melds[used++] = candidates[i];
+            if (coverMelds(candidates, count, remaining & ~candidates[i], melds, used)) {
+                return true;
+            }
+            --used;
+        }
+    }
+    return false;
+}
+
+}
+
+// Implementacija funkcije rawDeadwood
+int rawDeadwood(CardMask cards, RuleVariant variant) {
+    return rowDeadwood(ROW_VALUES.values[variant], cards);
+}
+
+// Implementacija funkcije minDeadwood
+int minDeadwood(CardMask hand, RuleVariant variant, CardMask* melded) {
+    const uint8_t* values = ROW_VALUES.values[variant];
+    int best = rowDeadwood(values, hand);
+    CardMask bestRemaining = hand;
+    if (hasMeld(hand, variant)) {
+        CardMask melds[MAX_HAND_MELDS];
+        int count = collectMelds(hand, ruleSet(variant), melds);
+        searchMelds(values, melds, count, 0, hand, best, bestRemaining);
+    }
+    if (melded) {
+        *melded = hand & ~bestRemaining;
+    }
+    return best;
+}
+
+// Implementacija funkcije splitMelds
+int splitMelds(CardMask melded, RuleVariant variant, CardMask* melds) {
+    CardMask candidates[MAX_HAND_MELDS];
+    int count = collectMelds(melded, ruleSet(variant), candidates);
+    int used = 0;
+    return coverMelds(candidates, count, melded, melds, used) ? used : -1;
+}
+
+// Implementacija funkcije canGoOut
+bool canGoOut(CardMask hand, int knockLimit, RuleVariant variant) {
+    int limit = knockLimit < 0 ? 0 : knockLimit;
+    if (rawDeadwood(hand & ~meldableCards(hand, variant), variant) > limit) {
+        return false;
+    }
+    return minDeadwood(hand, variant) <= limit;
+}
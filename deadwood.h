@@ -0,0 +1,89 @@
+#ifndef DEADWOOD_H
+#define DEADWOOD_H
+
+#include "cardmask.h"
+#include "rules.h"
+
+// Deadwood: zbroj vrijednosti karata koje nisu u meldovima, po vrijednostima varijante
+// (rankPenalty; za gin as 1, slike 10). Meld je set (3-4 karte istog ranga) ili niz
+// (3+ uzastopne karte iste boje; as je nizak, a uz aceHigh/wrapAround i Q-K-A, odnosno K-A-2).
+
+// Vrijednost karata u maski bez meldova; četiri pretrage tablice po retku boje
+int rawDeadwood(CardMask cards, RuleVariant variant = GIN_RUMMY);
+
+// Nizovi od tri karte oko asa koje pomaci unutar retka ne vide (Q-K-A i K-A-2), kao bit na mjestu
+// kralja svake boje u kojoj postoje; za gin nula
+inline CardMask aceRunKings(CardMask cards, RuleVariant variant) {
+    const RuleSet& rules = ruleSet(variant);
+    CardMask kings = cards & rankMask(NUM_RANKS - 1) & (cards << (NUM_RANKS - 1));
+    CardMask high = rules.aceHigh || rules.wrapAround ? kings & (cards << 1) : 0;
+    CardMask wrap = rules.wrapAround ? kings & (cards << (NUM_RANKS - 2)) : 0;
+    return high | wrap;
+}
+
+// Sadrži li maska barem jedan meld; bez petlji, samo operacije nad recima boja
+inline bool hasMeld(CardMask cards, RuleVariant variant = GIN_RUMMY) {
+    CardMask a = cards & SUIT_ROW_MASK;
+    CardMask b = (cards >> NUM_RANKS) & SUIT_ROW_MASK;
+    CardMask c = (cards >> (2 * NUM_RANKS)) & SUIT_ROW_MASK;
+    CardMask d = (cards >> (3 * NUM_RANKS)) & SUIT_ROW_MASK;
+    CardMask sets = (a & b & (c | d)) | (c & d & (a | b));
+    CardMask runs = cards & (cards >> 1) & (cards >> 2);
+    // Niz ne smije prelaziti granicu boje: najniža karta niza mora biti rang 0..10 unutar retka
+    const CardMask RUN_STARTS = ((1ULL << (NUM_RANKS - 2)) - 1) * (1ULL | (1ULL << NUM_RANKS) |
+        (1ULL << (2 * NUM_RANKS)) | (1ULL << (3 * NUM_RANKS)));
+    return sets != 0 || (runs & RUN_STARTS) != 0 || aceRunKings(cards, variant) != 0;
+}
+
+// Karte koje mogu biti u nekom meldu (rang prisutan u barem tri boje ili dio tri uzastopne karte boje);
+// ostale karte sigurno ostaju deadwood, pa rawDeadwood(cards & ~meldableCards(cards)) je donja granica.
+// Dulji nizovi preko asa sastoje se od nizova od tri karte pa je dovoljno dodati Q-K-A i K-A-2.
+inline CardMask meldableCards(CardMask cards, RuleVariant variant = GIN_RUMMY) {
+    CardMask a = cards & SUIT_ROW_MASK;
+    CardMask b = (cards >> NUM_RANKS) & SUIT_ROW_MASK;
+    CardMask c = (cards >> (2 * NUM_RANKS)) & SUIT_ROW_MASK;
+    CardMask d = (cards >> (3 * NUM_RANKS)) & SUIT_ROW_MASK;
+    CardMask sets = (a & b & (c | d)) | (c & d & (a | b));
+    sets |= (sets << NUM_RANKS) | (sets << (2 * NUM_RANKS)) | (sets << (3 * NUM_RANKS));
+    const CardMask RUN_STARTS = ((1ULL << (NUM_RANKS - 2)) - 1) * (1ULL | (1ULL << NUM_RANKS) |
+        (1ULL << (2 * NUM_RANKS)) | (1ULL << (3 * NUM_RANKS)));
+    CardMask runs = cards & (cards >> 1) & (cards >> 2) & RUN_STARTS;
+    runs |= (runs << 1) | (runs << 2);
+
+    // Kralj i as iz aceRunKings, uz damu (Q-K-A) ili dvojku (K-A-2) ako je ta karta prisutna
+    const RuleSet& rules = ruleSet(variant);
+    CardMask kings = aceRunKings(cards, variant);
+    runs |= kings | (kings >> (NUM_RANKS - 1));
+    runs |= rules.aceHigh || rules.wrapAround ? (kings >> 1) & cards & rankMask(NUM_RANKS - 2) : 0;
+    runs |= rules.wrapAround ? (kings >> (NUM_RANKS - 2)) & cards & rankMask(1) : 0;
+    return cards & (sets | runs);
+}
+
+// Najmanji deadwood po svim rasporedima karata u disjunktne meldove; melded (ako nije nullptr)
+// prima karte u meldovima za pronađeni raspored. Vrijednosti varijante utječu i na izbor meldova
+// (u 500 se as od 15 bodova radije meldira nego slika).
+int minDeadwood(CardMask hand, RuleVariant variant, CardMask* melded = nullptr);
+
+inline int minDeadwood(CardMask hand, CardMask* melded = nullptr) {
+    return minDeadwood(hand, GIN_RUMMY, melded);
+}
+
+// Rastavlja karte u meldovima (melded iz minDeadwood) na disjunktne meldove; melds mora imati mjesta
+// za popCount(melded) / 3 meldova. Vraća broj meldova, ili -1 ako se karte ne mogu potpuno rastaviti.
+int splitMelds(CardMask melded, RuleVariant variant, CardMask* melds);
+
+// Može li ruka izaći: deadwood najviše knockLimit, ili 0 kad je knockLimit negativan (bez kucanja).
+// Donja granica odbija gotovo sve ruke bez pretrage, točna pretraga pokreće se samo za kandidate
+bool canGoOut(CardMask hand, int knockLimit, RuleVariant variant = GIN_RUMMY);
+
+// Isto za StaticRules<V>: granica kucanja i oblik nizova su konstante prevođenja
+template <typename Rules>
+inline bool canGoOut(CardMask hand) {
+    const int limit = Rules::knockLimit < 0 ? 0 : Rules::knockLimit;
+    if (rawDeadwood(hand & ~meldableCards(hand, Rules::variant), Rules::variant) > limit) {
+        return false;
+    }
+    return minDeadwood(hand, Rules::variant) <= limit;
+}
+
+#endif
@@ -0,0 +1,132 @@
+#include "discardpile.h"
+#include <cassert>
+#include <cstring>
+
+using namespace std;
+
+// Implementacija konstruktora klase DiscardPile
+// Hrpa nikad nema više od 52 karte; povijest se bez punjenja špila ograničava na 52 odbacivanja
+DiscardPile::DiscardPile() : historyLimit(0), discards(0) {
+    live.reserve(NUM_CARDS);
+    setHistoryLimit(NUM_CARDS);
+    clear();
+}
+
+// Implementacija funkcije push
+void DiscardPile::push(const Card& card, size_t player) {
+    int index = cardIndex(card);
+    CardMask bit = cardBit(index);
+
+    live.push_back(static_cast<uint8_t>(index));
+    if (entries.size() < historyLimit) {
+        entries.push_back({ static_cast<uint8_t>(index), static_cast<uint8_t>(player),
+            static_cast<uint16_t>(discards) });
+    }
+    ++discards;
+
+    everMask |= bit;
+    currentMask |= bit;
+    assert(player < MAX_PLAYERS);
+    playerMasks[player] |= bit;
+    lastDiscarder[index] = static_cast<int8_t>(player);
+}
+
+// Implementacija funkcije top
+Card DiscardPile::top() const {
+    return cardFromIndex(live.back());
+}
+
+// Implementacija funkcije take (igrač uzima gornju kartu)
+Card DiscardPile::take() {
+    int index = live.back();
+    live.pop_back();
+    currentMask &= ~cardBit(index);
+    return cardFromIndex(index);
+}
+
+// Implementacija funkcije takeAllButTop (za vraćanje hrpe u špil; gornja karta ostaje)
+size_t DiscardPile::takeAllButTop(uint8_t* out) {
+    if (live.size() < 2) {
+        return 0;
+    }
+    size_t count = live.size() - 1;
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = live[i];
+        currentMask &= ~cardBit(live[i]);
+    }
+    live[0] = live.back();
+    live.resize(1);
+    return count;
+}
+
+// Implementacija funkcije empty
+bool DiscardPile::empty() const {
+    return live.empty();
+}
+
+// Implementacija funkcije size
+size_t DiscardPile::size() const {
+    return live.size();
+}
+
+// Implementacija funkcije clear
+void DiscardPile::clear() {
+    live.clear();
+    entries.clear();
+    discards = 0;
+    everMask = 0;
+    currentMask = 0;
+    memset(playerMasks, 0, sizeof(playerMasks));
+    memset(lastDiscarder, NO_PLAYER, sizeof(lastDiscarder));
+}
+
+// Implementacija funkcije setHistoryLimit (kapacitet se rezervira odmah pa push ne realocira)
+void DiscardPile::setHistoryLimit(size_t limit) {
+    historyLimit = limit;
+    entries.reserve(limit);
+    if (entries.size() > limit) {
+        entries.resize(limit);
+    }
+}
+
+// Implementacija funkcije wasDiscarded
+bool DiscardPile::wasDiscarded(const Card& card) const {
+    return (everMask & cardBit(cardIndex(card))) != 0;
+}
+
+// Implementacija funkcije wasDiscardedBy
+bool DiscardPile::wasDiscardedBy(const Card& card, size_t player) const {
+    assert(player < MAX_PLAYERS);
+    return (playerMasks[player] & cardBit(cardIndex(card))) != 0;
+}
+
+// Implementacija funkcije lastDiscardedBy (NO_PLAYER ako karta nikad nije odbačena)
+int DiscardPile::lastDiscardedBy(const Card& card) const {
+    return lastDiscarder[cardIndex(card)];
+}
+
+// Implementacija funkcije discardedMask
+CardMask DiscardPile::discardedMask() const {
+    return everMask;
+}
+
+// Implementacija funkcije discardedMask za jednog igrača
+CardMask DiscardPile::discardedMask(size_t player) const {
+    assert(player < MAX_PLAYERS);
+    return playerMasks[player];
+}
+
+// Implementacija funkcije liveMask
+CardMask DiscardPile::liveMask() const {
+    return currentMask;
+}
+
+// Implementacija funkcije liveCards (od dna prema vrhu)
+const vector<uint8_t>& DiscardPile::liveCards() const {
+    return live;
+}
+
+// Implementacija funkcije history (najviše historyLimit prvih odbacivanja)
+const vector<DiscardEntry>& DiscardPile::history() const {
+    return entries;
+}
@@ -0,0 +1,56 @@
+#ifndef DISCARDPILE_H
+#define DISCARDPILE_H
+
+#include "cardmask.h"
+#include <cstdint>
+#include <vector>
+
+// Jedan zapis povijesti: karta kao bajt (cardIndex), igrač i redni broj odbacivanja
+struct DiscardEntry {
+    uint8_t card;
+    uint8_t player;
+    uint16_t ordinal;
+};
+
+// Zajednička hrpa odbačenih karata za cijeli stol.
+// Vrh je zadnji element, a maske omogućuju upite "je li karta X odbačena i tko ju je odbacio" u O(1).
+// Igrač je uvijek manji od MAX_PLAYERS (provjerava se assertom).
+// Povijest dobiva zapis za svako odbacivanje, pa bez granice raste s duljinom igre (punjenje špila
+// s hrpe vraća iste karte u igru); pamti se najviše historyLimit prvih odbacivanja, a maske i
+// lastDiscardedBy vrijede za sva.
+class DiscardPile {
+public:
+    static const size_t MAX_PLAYERS = 8;
+    static const int NO_PLAYER = -1;
+
+    DiscardPile();
+    void push(const Card& card, size_t player);
+    Card top() const;
+    Card take();
+    size_t takeAllButTop(uint8_t* out);
+    bool empty() const;
+    std::size_t size() const;
+    void clear();
+    void setHistoryLimit(std::size_t limit);
+
+    bool wasDiscarded(const Card& card) const;
+    bool wasDiscardedBy(const Card& card, size_t player) const;
+    int lastDiscardedBy(const Card& card) const;
+    CardMask discardedMask() const;
+    CardMask discardedMask(size_t player) const;
+    CardMask liveMask() const;
+    const std::vector<DiscardEntry>& history() const;
+    const std::vector<uint8_t>& liveCards() const;
+
+private:
+    std::vector<uint8_t> live;
+    std::vector<DiscardEntry> entries;
+    std::size_t historyLimit;
+    std::size_t discards;
+    CardMask everMask;
+    CardMask currentMask;
+    CardMask playerMasks[MAX_PLAYERS];
+    int8_t lastDiscarder[NUM_CARDS];
+};
+
+#endif
@@ -0,0 +1,324 @@
+#include "evaluator.h"
+#include <cstring>
+#include <fstream>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const char WEIGHTS_MAGIC[4] = { 'R', 'M', 'E', 'V' };
+const uint32_t WEIGHTS_VERSION = 1;
+
+// Kaznene vrijednosti karata kao u RummyGame::getCardValue (indeks ranga 0..12)
+int defaultCardPenalty(int index) {
+    int rank = index % NUM_RANKS + 1;
+    return rank > 10 ? 10 : rank;
+}
+
+template <typename T>
+bool readValues(ifstream& in, T* values, size_t count) {
+    in.read(reinterpret_cast<char*>(values), static_cast<streamsize>(sizeof(T) * count));
+    return static_cast<bool>(in);
+}
+
+template <typename T>
+void writeValues(ofstream& out, const T* values, size_t count) {
+    out.write(reinterpret_cast<const char*>(values), static_cast<streamsize>(sizeof(T) * count));
+}
+
+}
+
+// Implementacija konstruktora klase Evaluator
+// Zadane težine su samo zbroj kaznenih vrijednosti karata u ruci; meldovi se ne prepoznaju,
+// pa bot bez naučenih težina odbacuje najskuplju kartu, a ne onu koja najviše smanjuje deadwood.
+Evaluator::Evaluator() : hidden(0), hiddenScale(1.0f), outputBias(0.0f) {
+    for (int i = 0; i < NUM_CARDS; ++i) {
+        linearWeights[i] = -static_cast<float>(defaultCardPenalty(i));
+        linearWeights[NUM_CARDS + i] = 0.0f;
+    }
+}
+
+// Implementacija funkcije loadWeights
+bool Evaluator::loadWeights(const string& path) {
+    ifstream in(path, ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    uint32_t hiddenCount = 0;
+    if (!readValues(in, magic, 4) || memcmp(magic, WEIGHTS_MAGIC, 4) != 0 ||
+        !readValues(in, &version, 1) || version != WEIGHTS_VERSION ||
+        !readValues(in, &hiddenCount, 1)) {
+        return false;
+    }
+    // Skriveni sloj mora biti višekratnik od 8 zbog SIMD akumulacije
+    if (hiddenCount > static_cast<uint32_t>(MAX_HIDDEN) || hiddenCount % 8 != 0) {
+        return false;
+    }
+
+    float scale = 0.0f;
+    float bias = 0.0f;
+    float linear[NUM_FEATURES];
+    vector<int8_t> weights(static_cast<size_t>(NUM_FEATURES) * hiddenCount);
+    vector<int32_t> biases(hiddenCount);
+    vector<float> output(hiddenCount);
+    if (!readValues(in, &scale, 1) || !readValues(in, &bias, 1) ||
+        !readValues(in, linear, NUM_FEATURES) ||
+        !readValues(in, weights.data(), weights.size()) ||
+        !readValues(in, biases.data(), biases.size()) ||
+        !readValues(in, output.data(), output.size())) {
+        return false;
+    }
+
+    hidden = static_cast<int>(hiddenCount);
+    hiddenScale = scale;
+    outputBias = bias;
+    memcpy(linearWeights, linear, sizeof(linearWeights));
+    inputWeights.swap(weights);
+    hiddenBias.swap(biases);
+    outputWeights.swap(output);
+    return true;
+}
+
+// Implementacija funkcije saveWeights
+bool Evaluator::saveWeights(const string& path) const {
+    ofstream out(path, ios::binary);
+    if (!out) {
+        return false;
+    }
+
+    uint32_t hiddenCount = static_cast<uint32_t>(hidden);
+    writeValues(out, WEIGHTS_MAGIC, 4);
+    writeValues(out, &WEIGHTS_VERSION, 1);
+    writeValues(out, &hiddenCount, 1);
+    writeValues(out, &hiddenScale, 1);
+    writeValues(out, &outputBias, 1);
+    writeValues(out, linearWeights, NUM_FEATURES);
+    writeValues(out, inputWeights.data(), inputWeights.size());
+    writeValues(out, hiddenBias.data(), hiddenBias.size());
+    writeValues(out, outputWeights.data(), outputWeights.size());
+    return static_cast<bool>(out);
+}
+
+// Implementacija funkcije evaluate
+float Evaluator::evaluate(CardMask hand, CardMask discards) const {
+    float value;
+    evaluateBatch(&hand, &discards, 1, &value);
+    return value;
+}
+
+// Implementacija funkcije evaluateBatch
+void Evaluator::evaluateBatch(const CardMask* hands, const CardMask* discards, size_t count, float* out) const {
+    for (size_t n = 0; n < count; ++n) {
+        float value = outputBias;
+
+        // Ulazi su binarni pa je linearni dio samo zbroj težina postavljenih bitova
+        for (CardMask bits = hands[n]; bits; bits &= bits - 1) {
+            value += linearWeights[lowestCard(bits)];
+        }
+        for (CardMask bits = discards[n]; bits; bits &= bits - 1) {
+            value += linearWeights[NUM_CARDS + lowestCard(bits)];
+        }
+
+        if (hidden > 0) {
+            value += evaluateHidden(hands[n], discards[n]);
+        }
+        out[n] = value;
+    }
+}
+
+// Implementacija funkcije evaluateHidden
+float Evaluator::evaluateHidden(CardMask hand, CardMask discards) const {
+    alignas(32) int32_t acc[MAX_HIDDEN];
+    accumulate(hand, discards, acc);
+    return hiddenOutput(acc);
+}
+
+// Implementacija funkcije accumulate (prvi sloj: za svaki postavljeni ulaz dodaje se jedan redak int8 težina)
+void Evaluator::accumulate(CardMask hand, CardMask discards, int32_t* acc) const {
+    memcpy(acc, hiddenBias.data(), sizeof(int32_t) * hidden);
+    for (CardMask bits = hand; bits; bits &= bits - 1) {
+        addRow(acc, lowestCard(bits), 1);
+    }
+    for (CardMask bits = discards; bits; bits &= bits - 1) {
+        addRow(acc, NUM_CARDS + lowestCard(bits), 1);
+    }
+}
+
+// Implementacija funkcije addRow (sign je 1 ili -1)
+void Evaluator::addRow(int32_t* acc, int feature, int sign) const {
+    const int8_t* row = &inputWeights[static_cast<size_t>(feature) * hidden];
+#ifdef __AVX2__
+    for (int h = 0; h < hidden; h += 8) {
+        __m256i weights = _mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + h)));
+        __m256i current = _mm256_load_si256(reinterpret_cast<const __m256i*>(acc + h));
+        __m256i sum = sign > 0 ? _mm256_add_epi32(current, weights) : _mm256_sub_epi32(current, weights);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(acc + h), sum);
+    }
+#else
+    for (int h = 0; h < hidden; ++h) {
+        acc[h] += sign * row[h];
+    }
+#endif
+}
+
+// Implementacija funkcije hiddenOutput (ReLU, dekvantizacija i izlazni sloj)
+float Evaluator::hiddenOutput(const int32_t* acc) const {
+    float value = 0.0f;
+    for (int h = 0; h < hidden; ++h) {
+        int32_t activation = acc[h] > 0 ? acc[h] : 0;
+        value += static_cast<float>(activation) * hiddenScale * outputWeights[h];
+    }
+    return value;
+}
+
+// Implementacija funkcije evaluateDiscards
+// Procjene za svako odbacivanje iz ruke, rastućim indeksom karte. Zbroj za cijelu ruku računa se
+// jednom, a svaki kandidat samo oduzima redak karte iz ruke i dodaje redak iste karte na hrpi.
+void Evaluator::evaluateDiscards(CardMask hand, CardMask discards, float* out) const {
+    float base = outputBias;
+    for (CardMask bits = hand; bits; bits &= bits - 1) {
+        base += linearWeights[lowestCard(bits)];
+    }
+    for (CardMask bits = discards; bits; bits &= bits - 1) {
+        base += linearWeights[NUM_CARDS + lowestCard(bits)];
+    }
+
+    alignas(32) int32_t baseAcc[MAX_HIDDEN];
+    alignas(32) int32_t acc[MAX_HIDDEN];
+    if (hidden > 0) {
+        accumulate(hand, discards, baseAcc);
+    }
+
+    size_t i = 0;
+    for (CardMask bits = hand; bits; bits &= bits - 1, ++i) {
+        int card = lowestCard(bits);
+        // Karta uzeta s hrpe već je među odbačenima pa se njezin ulaz ne dodaje ponovno
+        bool fresh = (discards & cardBit(card)) == 0;
+        float value = base - linearWeights[card] + (fresh ? linearWeights[NUM_CARDS + card] : 0.0f);
+        if (hidden > 0) {
+            memcpy(acc, baseAcc, sizeof(int32_t) * hidden);
+            addRow(acc, card, -1);
+            if (fresh) {
+                addRow(acc, NUM_CARDS + card, 1);
+            }
+            value += hiddenOutput(acc);
+        }
+        out[i] = value;
+    }
+}
+
+// Implementacija funkcije bestDiscard (kod jednakih procjena bira se karta s manjim indeksom)
+int Evaluator::bestDiscard(CardMask hand, CardMask discards, float& bestValue) const {
+    float values[NUM_CARDS];
+    evaluateDiscards(hand, discards, values);
+
+    int best = -1;
+    size_t i = 0;
+    for (CardMask bits = hand; bits; bits &= bits - 1, ++i) {
+        if (best < 0 || values[i] > bestValue) {
+            best = lowestCard(bits);
+            bestValue = values[i];
+        }
+    }
+    return best;
+}
+
+// Implementacija funkcije bestDiscardBatch
+// Najbolja odbacivanja za count ruku odjednom, isti rezultat kao bestDiscard za svaku ruku.
+// Uz AVX2 linearni model računa DISCARD_LANES ruku istovremeno: maske se prevode u 32-bitne
+// polovice po trakama, a petlja ide po kartama pa svaka karta učita svoje težine jednom za sve trake.
+// Skriveni sloj ima akumulator po ruci, a bez AVX2 gusta petlja po svim kartama sporija je od
+// obilaska postavljenih bitova, pa se tada računa ruku po ruku.
+void Evaluator::bestDiscardBatch(const CardMask* hands, const CardMask* discards, size_t count, int* best,
+    float* bestValues) const {
+#ifdef __AVX2__
+    if (hidden == 0) {
+        discardBlocks(hands, discards, count, best, bestValues);
+        return;
+    }
+#endif
+    for (size_t n = 0; n < count; ++n) {
+        best[n] = bestDiscard(hands[n], discards[n], bestValues[n]);
+    }
+}
+
+#ifdef __AVX2__
+// Implementacija funkcije discardBlocks
+void Evaluator::discardBlocks(const CardMask* hands, const CardMask* discards, size_t count, int* best,
+    float* bestValues) const {
+    alignas(32) uint32_t handWords[2 * DISCARD_LANES];
+    alignas(32) uint32_t discardWords[2 * DISCARD_LANES];
+    alignas(32) int32_t laneBest[DISCARD_LANES];
+    alignas(32) float laneValues[DISCARD_LANES];
+    for (size_t first = 0; first < count; first += DISCARD_LANES) {
+        size_t lanes = count - first < DISCARD_LANES ? count - first : DISCARD_LANES;
+        // Prazne trake nemaju karata u ruci pa ne mijenjaju ništa
+        for (size_t k = 0; k < DISCARD_LANES; ++k) {
+            CardMask hand = k < lanes ? hands[first + k] : 0;
+            CardMask pile = k < lanes ? discards[first + k] : 0;
+            handWords[k] = static_cast<uint32_t>(hand);
+            handWords[DISCARD_LANES + k] = static_cast<uint32_t>(hand >> 32);
+            discardWords[k] = static_cast<uint32_t>(pile);
+            discardWords[DISCARD_LANES + k] = static_cast<uint32_t>(pile >> 32);
+        }
+        discardLanes(handWords, discardWords, laneBest, laneValues);
+        for (size_t k = 0; k < lanes; ++k) {
+            best[first + k] = laneBest[k];
+            bestValues[first + k] = laneValues[k];
+        }
+    }
+}
+
+// Implementacija funkcije discardLanes
+// Redoslijed zbrajanja je isti kao u evaluateDiscards (ruka pa hrpa, rastućim indeksom karte), a
+// karte izvan ruke dodaju točnu nulu, pa su procjene bit po bit jednake skalarnima.
+void Evaluator::discardLanes(const uint32_t* handWords, const uint32_t* discardWords, int32_t* best,
+    float* bestValues) const {
+    const __m256i hand[2] = { _mm256_load_si256(reinterpret_cast<const __m256i*>(handWords)),
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(handWords + DISCARD_LANES)) };
+    const __m256i pile[2] = { _mm256_load_si256(reinterpret_cast<const __m256i*>(discardWords)),
+        _mm256_load_si256(reinterpret_cast<const __m256i*>(discardWords + DISCARD_LANES)) };
+    auto hasCard = [](const __m256i* words, int card) {
+        __m256i bit = _mm256_set1_epi32(static_cast<int>(1u << (card & 31)));
+        return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(words[card >> 5], bit), bit));
+    };
+
+    __m256 base = _mm256_set1_ps(outputBias);
+    for (int card = 0; card < NUM_CARDS; ++card) {
+        base = _mm256_add_ps(base, _mm256_and_ps(hasCard(hand, card), _mm256_set1_ps(linearWeights[card])));
+    }
+    for (int card = 0; card < NUM_CARDS; ++card) {
+        __m256 weight = _mm256_set1_ps(linearWeights[NUM_CARDS + card]);
+        base = _mm256_add_ps(base, _mm256_and_ps(hasCard(pile, card), weight));
+    }
+
+    // Kod jednakih procjena ostaje karta s manjim indeksom (stroga usporedba, rastući indeksi)
+    __m256 bestValue = _mm256_setzero_ps();
+    __m256 found = _mm256_setzero_ps();
+    const __m256 allLanes = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+    __m256i bestCard = _mm256_set1_epi32(-1);
+    for (int card = 0; card < NUM_CARDS; ++card) {
+        __m256 fresh = _mm256_andnot_ps(hasCard(pile, card), _mm256_set1_ps(linearWeights[NUM_CARDS + card]));
+        __m256 value = _mm256_add_ps(_mm256_sub_ps(base, _mm256_set1_ps(linearWeights[card])), fresh);
+        __m256 better = _mm256_or_ps(_mm256_xor_ps(found, allLanes), _mm256_cmp_ps(value, bestValue, _CMP_GT_OQ));
+        __m256 take = _mm256_and_ps(hasCard(hand, card), better);
+        bestValue = _mm256_blendv_ps(bestValue, value, take);
+        bestCard = _mm256_blendv_epi8(bestCard, _mm256_set1_epi32(card), _mm256_castps_si256(take));
+        found = _mm256_or_ps(found, take);
+    }
+    _mm256_store_ps(bestValues, bestValue);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(best), bestCard);
+}
+#endif
+
+// Implementacija funkcije hiddenSize
+int Evaluator::hiddenSize() const {
+    return hidden;
+}
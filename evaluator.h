@@ -0,0 +1,48 @@
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include "cardmask.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Procjena vrijednosti ruke: ulaz su 52 bita ruke i 52 bita odbačenih karata.
+// Model je linearni dio plus opcionalni skriveni sloj s int8 težinama.
+class Evaluator {
+public:
+    static const int NUM_FEATURES = 2 * NUM_CARDS;
+    static const int MAX_HIDDEN = 64;
+    static const size_t DISCARD_LANES = 8;
+
+    Evaluator();
+    bool loadWeights(const std::string& path);
+    bool saveWeights(const std::string& path) const;
+    float evaluate(CardMask hand, CardMask discards) const;
+    void evaluateBatch(const CardMask* hands, const CardMask* discards, size_t count, float* out) const;
+    void evaluateDiscards(CardMask hand, CardMask discards, float* out) const;
+    int bestDiscard(CardMask hand, CardMask discards, float& bestValue) const;
+    void bestDiscardBatch(const CardMask* hands, const CardMask* discards, size_t count, int* best,
+        float* bestValues) const;
+    int hiddenSize() const;
+
+private:
+    int hidden;
+    float hiddenScale;
+    float outputBias;
+    std::vector<int8_t> inputWeights;
+    std::vector<int32_t> hiddenBias;
+    std::vector<float> outputWeights;
+    float linearWeights[NUM_FEATURES];
+
+    float evaluateHidden(CardMask hand, CardMask discards) const;
+    void accumulate(CardMask hand, CardMask discards, int32_t* acc) const;
+    void addRow(int32_t* acc, int feature, int sign) const;
+    float hiddenOutput(const int32_t* acc) const;
+#ifdef __AVX2__
+    void discardBlocks(const CardMask* hands, const CardMask* discards, size_t count, int* best,
+        float* bestValues) const;
+    void discardLanes(const uint32_t* handWords, const uint32_t* discardWords, int32_t* best, float* bestValues) const;
+#endif
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef FASTRNG_H
+#define FASTRNG_H
+
+#include "cardmask.h"
+#include <cstdint>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+// Lagani generator (SplitMix64): stanje je jedna 64-bitna riječ pa je sijanje besplatno,
+// za razliku od mt19937 čije sijanje dominira cijenom kratkih simulacija.
+class FastRng {
+public:
+    explicit FastRng(uint64_t seed = 0) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // Uniformni broj u [0, bound) bez pristranosti (Lemireova metoda); bound mora biti veći od 0
+    uint32_t below(uint32_t bound) {
+        uint64_t product = (next() >> 32) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+            while (low < threshold) {
+                product = (next() >> 32) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+private:
+    uint64_t state;
+};
+
+// Indeks k-te postavljene karte u maski (k od 0)
+inline int selectCard(CardMask mask, int k) {
+#if defined(__BMI2__)
+    return lowestCard(_pdep_u64(1ULL << k, mask));
+#else
+    // Preskakanje po bajtovima pa traženje unutar bajta
+    int base = 0;
+    for (;;) {
+        int count = popCount(mask & 0xFF);
+        if (k < count) {
+            break;
+        }
+        k -= count;
+        mask >>= 8;
+        base += 8;
+    }
+    for (; k > 0; --k) {
+        mask &= mask - 1;
+    }
+    return base + lowestCard(mask);
+#endif
+}
+
+// Uniformno izvlačenje iz skupa neviđenih karata bez miješanja cijelog špila (za rollout-e);
+// -1 ako je skup prazan (below(0) nije definiran)
+inline int drawRandomCard(CardMask& unseen, FastRng& rng) {
+    if (unseen == 0) {
+        return -1;
+    }
+    int card = selectCard(unseen, static_cast<int>(rng.below(static_cast<uint32_t>(popCount(unseen)))));
+    unseen &= ~cardBit(card);
+    return card;
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+
+#include "cardmask.h"
+#include "layoff.h"
+#include <cstdint>
+
+// Kompaktno stanje igre za pretraživanje: ruke i meldovi su bitmaske,
+// špil i hrpa su nizovi bajtova (vrh je zadnji element). Kopira se memcpy-jem.
+// suitKeys su Zobrist zbrojevi po bojama (canonical.h), održavaju ih makeMove/unmakeMove.
+struct GameState {
+    static const size_t MAX_PLAYERS = 4;
+    static const size_t MAX_MELDS = LayoffIndex::MAX_MELDS;
+    static const uint8_t NO_CARD = 0xFF;
+
+    enum Phase : uint8_t { DRAW, PLAY };
+
+    CardMask hands[MAX_PLAYERS];
+    CardMask melds[MAX_MELDS];
+    uint8_t meldOwner[MAX_MELDS];
+    LayoffIndex layoffs;
+    uint8_t stock[NUM_CARDS];
+    uint8_t discards[NUM_CARDS];
+    uint64_t suitKeys[NUM_SUITS];
+    uint8_t stockCount;
+    uint8_t discardCount;
+    uint8_t meldCount;
+    uint8_t numPlayers;
+    uint8_t current;
+    uint8_t phase;
+    uint8_t takenDiscard;
+    uint8_t variant;    // RuleVariant; određuje nizove preko asa (movegen, meldExtensions)
+
+    bool isTerminal() const {
+        return phase == DRAW && stockCount == 0;
+    }
+
+    CardMask tableMask() const {
+        CardMask mask = 0;
+        for (uint8_t i = 0; i < meldCount; ++i) {
+            mask |= melds[i];
+        }
+        return mask;
+    }
+};
+
+#endif
@@ -0,0 +1,310 @@
+#include "cardmask.h"
+#include "combinations.h"
+#include "deadwood.h"
+#include "fastrng.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Točna statistika deadwooda po svim rukama od k karata iz špila od d karata.
+// Prostor kombinacija dijeli se po dvije najviše karte ruke (indeks karte = boja * 13 + rang);
+// ostatak ruke obilazi se Grayevim kodom pa se sirovi deadwood mijenja za dvije karte po koraku,
+// a točno rješenje traži se samo za ruke koje sadrže barem jedan meld.
+// Izlaz su histogrami, ne tablica po ruci: za k = 10 tablica bi imala C(52, 10) ≈ 1,6 · 10^10 zapisa.
+// --verify uspoređuje histograme i deadwood slučajnih ruku s neovisnom rekurzivnom pretragom.
+
+namespace {
+
+const char STATS_MAGIC[4] = { 'R', 'M', 'H', 'S' };
+const uint32_t STATS_VERSION = 1;
+
+struct WorkItem {
+    int top;
+    int second;
+};
+
+struct Histograms {
+    vector<uint64_t> minimum;
+    vector<uint64_t> raw;
+    uint64_t hands;
+
+    explicit Histograms(size_t bins) : minimum(bins, 0), raw(bins, 0), hands(0) {}
+};
+
+void printUsage() {
+    cout << "Usage: rummy_handstats [-k handSize] [-d deckSize] [-t threads] [-o outputPrefix]\n"
+        "       rummy_handstats --verify [-k handSize] [-d deckSize]\n";
+}
+
+// Sve ruke s najvišim kartama top i second; ostalih k - 2 karata bira se iz [0, second)
+void enumerateItem(const WorkItem& item, int handSize, const int* cardValues, Histograms& histograms) {
+    RevolvingDoor door(item.second, handSize - 2);
+    CardMask hand = cardBit(item.top) | cardBit(item.second) | door.mask();
+    int raw = rawDeadwood(hand);
+    int removed = 0;
+    int added = 0;
+    for (;;) {
+        ++histograms.raw[raw];
+        ++histograms.minimum[hasMeld(hand) ? minDeadwood(hand) : raw];
+        ++histograms.hands;
+        if (!door.next(removed, added)) {
+            break;
+        }
+        hand ^= cardBit(removed) | cardBit(added);
+        raw += cardValues[added] - cardValues[removed];
+    }
+}
+
+// Referentni deadwood bez popisa meldova: najniža karta ruke je ili deadwood, ili je u setu
+// (s kartama istog ranga viših boja), ili je u nekom nizu svoje boje. Niz se gradi po pozicijama:
+// početak ide od karte prema dolje (uz wrapAround i preko asa na kralja), a as uz aceHigh ima i
+// poziciju 13 iznad kralja; rang pozicije je pozicija mod 13.
+int bruteDeadwood(CardMask hand, const RuleSet& rules) {
+    if (hand == 0) {
+        return 0;
+    }
+    int card = lowestCard(hand);
+    int rank = card % NUM_RANKS;
+    int suitBase = card - rank;
+    CardMask rest = hand & ~cardBit(card);
+    int best = rankPenalty(rules, rank) + bruteDeadwood(rest, rules);
+
+    CardMask others = rest & rankMask(rank);
+    for (CardMask subset = others; subset; subset = (subset - 1) & others) {
+        if (popCount(subset) >= 2) {
+            int value = bruteDeadwood(rest & ~subset, rules);
+            best = value < best ? value : best;
+        }
+    }
+    bool highAce = rank == 0 && rules.aceHigh && !rules.wrapAround;
+    for (int position = rank; position <= (highAce ? NUM_RANKS : rank); position += NUM_RANKS) {
+        for (int below = position == NUM_RANKS ? 1 : 0; below < NUM_RANKS; ++below) {
+            int start = position - below;
+            if (start < 0 && !rules.wrapAround) {
+                break;
+            }
+            int low = (start + NUM_RANKS) % NUM_RANKS;
+            if (!(hand & cardBit(suitBase + low))) {
+                break;
+            }
+            for (int length = below + 1; runFits(rules, low, length > 3 ? length : 3); ++length) {
+                if (!(hand & cardBit(suitBase + (low + length - 1) % NUM_RANKS))) {
+                    break;
+                }
+                if (length >= 3) {
+                    int value = bruteDeadwood(hand & ~(runRow(low, length) << suitBase), rules);
+                    best = value < best ? value : best;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+// Slaže li se canGoOut<StaticRules<V>> s izvedbom koja pravila čita u vremenu izvođenja
+bool staticGoOutMatches(RuleVariant variant, CardMask hand) {
+    bool matches = false;
+    withRules(variant, [&](auto rules) {
+        const RuleSet& set = ruleSet(variant);
+        matches = canGoOut<decltype(rules)>(hand) == canGoOut(hand, set.knockLimit, variant);
+    });
+    return matches;
+}
+
+// Sve ruke od handSize karata iz [0, deckSize) običnim nabrajanjem kombinacija
+void bruteHistograms(CardMask hand, int first, int left, int deckSize, Histograms& histograms) {
+    if (left == 0) {
+        ++histograms.raw[rawDeadwood(hand)];
+        ++histograms.minimum[bruteDeadwood(hand, ruleSet(GIN_RUMMY))];
+        ++histograms.hands;
+        return;
+    }
+    for (int card = first; card <= deckSize - left; ++card) {
+        bruteHistograms(hand | cardBit(card), card + 1, left - 1, deckSize, histograms);
+    }
+}
+
+// Provjera: histogrami Grayeva obilaska jednaki su nabrajanju s referentnom pretragom, a za slučajne
+// ruke svake varijante minDeadwood, karte u meldovima i canGoOut (obje inačice) slažu se s referencom
+bool verify(int handSize, int deckSize, const int* cardValues) {
+    size_t bins = static_cast<size_t>(handSize) * 10 + 1;
+    Histograms enumerated(bins);
+    for (int second = deckSize - 2; second >= handSize - 2; --second) {
+        for (int top = second + 1; top < deckSize; ++top) {
+            enumerateItem({ top, second }, handSize, cardValues, enumerated);
+        }
+    }
+    Histograms reference(bins);
+    bruteHistograms(0, 0, handSize, deckSize, reference);
+    bool ok = enumerated.hands == reference.hands && enumerated.minimum == reference.minimum &&
+        enumerated.raw == reference.raw;
+    cout << "histograms k=" << handSize << " d=" << deckSize << ": " << reference.hands << " hands "
+        << (ok ? "ok" : "MISMATCH") << "\n";
+
+    const int SAMPLES = 20000;
+    FastRng rng(12345);
+    for (int v = 0; v < NUM_RULE_VARIANTS; ++v) {
+        RuleVariant variant = static_cast<RuleVariant>(v);
+        const RuleSet& rules = ruleSet(variant);
+        int checked = 0;
+        for (; checked < SAMPLES; ++checked) {
+            // Svaka druga ruka bira se iz dvije boje, pa su dugi nizovi i nizovi preko asa česti
+            CardMask unseen = checked % 2 ? FULL_DECK_MASK : (1ULL << (2 * NUM_RANKS)) - 1;
+            CardMask hand = 0;
+            for (int c = 0; c < rules.handSize; ++c) {
+                hand |= cardBit(drawRandomCard(unseen, rng));
+            }
+            CardMask melded = 0;
+            int expected = bruteDeadwood(hand, rules);
+            int actual = minDeadwood(hand, variant, &melded);
+            int limit = rules.knockLimit < 0 ? 0 : rules.knockLimit;
+            if (actual != expected || (melded & ~hand) != 0 || rawDeadwood(hand & ~melded, variant) != expected ||
+                canGoOut(hand, rules.knockLimit, variant) != (expected <= limit) ||
+                canGoOut(hand, -1, variant) != (expected == 0) || !staticGoOutMatches(variant, hand)) {
+                cout << rules.name << " hand 0x" << hex << hand << dec << ": minDeadwood " << actual
+                    << ", reference " << expected << " MISMATCH\n";
+                ok = false;
+                break;
+            }
+        }
+        cout << rules.name << ": " << checked << " random hands checked\n";
+    }
+    return ok;
+}
+
+bool writeBinary(const string& path, int handSize, int deckSize, const Histograms& histograms) {
+    ofstream out(path, ios::binary);
+    if (!out) {
+        return false;
+    }
+    uint32_t fields[4] = { STATS_VERSION, static_cast<uint32_t>(handSize), static_cast<uint32_t>(deckSize),
+        static_cast<uint32_t>(histograms.minimum.size()) };
+    out.write(STATS_MAGIC, 4);
+    out.write(reinterpret_cast<const char*>(fields), sizeof(fields));
+    out.write(reinterpret_cast<const char*>(&histograms.hands), sizeof(histograms.hands));
+    out.write(reinterpret_cast<const char*>(histograms.minimum.data()), sizeof(uint64_t) * histograms.minimum.size());
+    out.write(reinterpret_cast<const char*>(histograms.raw.data()), sizeof(uint64_t) * histograms.raw.size());
+    return static_cast<bool>(out);
+}
+
+bool writeCsv(const string& path, const Histograms& histograms) {
+    ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    out << "deadwood,min_hands,raw_hands\n";
+    for (size_t i = 0; i < histograms.minimum.size(); ++i) {
+        if (histograms.minimum[i] || histograms.raw[i]) {
+            out << i << "," << histograms.minimum[i] << "," << histograms.raw[i] << "\n";
+        }
+    }
+    return static_cast<bool>(out);
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int handSize = 10;
+    int deckSize = NUM_CARDS;
+    size_t threadCount = 0;
+    string prefix = "handstats";
+    bool verifyMode = false;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-k" && i + 1 < argc) {
+            handSize = atoi(argv[++i]);
+        }
+        else if (arg == "-d" && i + 1 < argc) {
+            deckSize = atoi(argv[++i]);
+        }
+        else if (arg == "-t" && i + 1 < argc) {
+            threadCount = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-o" && i + 1 < argc) {
+            prefix = argv[++i];
+        }
+        else if (arg == "--verify") {
+            verifyMode = true;
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (handSize < 4 || handSize - 2 > RevolvingDoor::MAX_T || deckSize > NUM_CARDS || deckSize < handSize) {
+        printUsage();
+        return 1;
+    }
+    if (threadCount == 0) {
+        threadCount = thread::hardware_concurrency() ? thread::hardware_concurrency() : 1;
+    }
+
+    int cardValues[NUM_CARDS];
+    for (int card = 0; card < NUM_CARDS; ++card) {
+        cardValues[card] = rawDeadwood(cardBit(card));
+    }
+    if (verifyMode) {
+        return verify(handSize, deckSize, cardValues) ? 0 : 1;
+    }
+
+    // Najveći poslovi (visoka druga karta) idu prvi da se dretve ravnomjerno napune
+    vector<WorkItem> items;
+    for (int second = deckSize - 2; second >= handSize - 2; --second) {
+        for (int top = second + 1; top < deckSize; ++top) {
+            items.push_back({ top, second });
+        }
+    }
+
+    size_t bins = static_cast<size_t>(handSize) * 10 + 1;
+    // Svaka dretva broji u svoje lokalne histograme i predaje ih tek na kraju, pa tijekom
+    // obilaska dretve ne pišu u susjedne linije predmemorije
+    vector<Histograms> results(threadCount, Histograms(0));
+    atomic<size_t> next(0);
+    auto start = chrono::steady_clock::now();
+    auto worker = [&](size_t t) {
+        Histograms local(bins);
+        for (size_t i = next++; i < items.size(); i = next++) {
+            enumerateItem(items[i], handSize, cardValues, local);
+        }
+        results[t] = move(local);
+    };
+    vector<thread> threads;
+    for (size_t t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    Histograms total(bins);
+    for (const Histograms& result : results) {
+        for (size_t i = 0; i < bins; ++i) {
+            total.minimum[i] += result.minimum[i];
+            total.raw[i] += result.raw[i];
+        }
+        total.hands += result.hands;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if (!writeBinary(prefix + ".bin", handSize, deckSize, total) || !writeCsv(prefix + ".csv", total)) {
+        cerr << "Error: cannot write " << prefix << ".bin/.csv\n";
+        return 1;
+    }
+    cout << "hands " << total.hands << "\n"
+        << "gin hands " << total.minimum[0] << "\n"
+        << "time " << seconds << " s (" << threadCount << " threads)\n"
+        << "hands/s " << static_cast<uint64_t>(seconds > 0.0 ? total.hands / seconds : 0.0) << "\n"
+        << "written " << prefix << ".bin, " << prefix << ".csv\n";
+    return 0;
+}
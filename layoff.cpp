@@ -0,0 +1,62 @@
+#include "layoff.h"
+#include <cstring>
+
+using namespace std;
+
+// Implementacija funkcije clear
+void LayoffIndex::clear() {
+    memset(extensions, 0, sizeof(extensions));
+    memset(coverage, 0, sizeof(coverage));
+    unionMask = 0;
+}
+
+// Implementacija funkcije setExtensions (ažurira samo promijenjene bitove)
+void LayoffIndex::setExtensions(size_t meld, CardMask mask) {
+    CardMask removed = extensions[meld] & ~mask;
+    CardMask added = mask & ~extensions[meld];
+    extensions[meld] = mask;
+
+    // Ista karta može produžiti više meldova (npr. set i niz), zato se broji pokrivenost
+    for (; removed; removed &= removed - 1) {
+        int card = lowestCard(removed);
+        if (--coverage[card] == 0) {
+            unionMask &= ~cardBit(card);
+        }
+    }
+    for (; added; added &= added - 1) {
+        int card = lowestCard(added);
+        if (coverage[card]++ == 0) {
+            unionMask |= cardBit(card);
+        }
+    }
+}
+
+// Implementacija funkcije meldExtensions (karte kojima se meld može produžiti)
+CardMask meldExtensions(CardMask meld, RuleVariant variant) {
+    int first = lowestCard(meld);
+    int rank = first % NUM_RANKS;
+    if ((meld & ~rankMask(rank)) == 0) {
+        // Set: nedostaju preostale boje istog ranga
+        return rankMask(rank) & ~meld;
+    }
+
+    // Niz: karta ispod početka i iza kraja, unutar iste boje. Početak je rang čiji prethodnik u krugu
+    // nije u nizu (Q-K-A počinje damom), a kraj iza kralja je as i dalje u krug, ako pravila to dopuštaju
+    int suitBase = (first / NUM_RANKS) * NUM_RANKS;
+    CardMask row = (meld >> suitBase) & SUIT_ROW_MASK;
+    int length = popCount(row);
+    if (length >= NUM_RANKS) {
+        return 0;
+    }
+    CardMask previous = ((row << 1) | (row >> (NUM_RANKS - 1))) & SUIT_ROW_MASK;
+    int low = lowestCard(row & ~previous);
+    const RuleSet& rules = ruleSet(variant);
+    CardMask extensions = 0;
+    if (low > 0 || rules.wrapAround) {
+        extensions |= 1ULL << ((low + NUM_RANKS - 1) % NUM_RANKS);
+    }
+    if (runFits(rules, low, length + 1)) {
+        extensions |= 1ULL << ((low + length) % NUM_RANKS);
+    }
+    return extensions << suitBase;
+}
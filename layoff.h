@@ -0,0 +1,32 @@
+#ifndef LAYOFF_H
+#define LAYOFF_H
+
+#include "cardmask.h"
+#include "rules.h"
+#include <cstdint>
+
+// Za svaki meld na stolu čuva masku karata koje ga produžuju i uniju tih maski.
+// Provjera može li se karta iz ruke dodati na stol je jedan AND s unionMask.
+struct LayoffIndex {
+    static const size_t MAX_MELDS = 18;
+
+    CardMask extensions[MAX_MELDS];
+    CardMask unionMask;
+    uint8_t coverage[NUM_CARDS];
+
+    void clear();
+    void setExtensions(size_t meld, CardMask mask);
+
+    bool canLayOff(int card) const {
+        return (unionMask & cardBit(card)) != 0;
+    }
+
+    CardMask candidates(CardMask hand) const {
+        return hand & unionMask;
+    }
+};
+
+// Karte kojima se meld može produžiti; nizovi preko asa prema pravilima varijante
+CardMask meldExtensions(CardMask meld, RuleVariant variant = GIN_RUMMY);
+
+#endif
@@ -0,0 +1,223 @@
+#include "livestats.h"
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+namespace {
+
+size_t scoreBin(int score) {
+    if (score < 0) {
+        return 0;
+    }
+    size_t bin = static_cast<size_t>(score);
+    return bin < StatsSketch::SCORE_BINS ? bin : StatsSketch::SCORE_BINS - 1;
+}
+
+}
+
+// Implementacija funkcije clear
+void StatsSketch::clear() {
+    memset(this, 0, sizeof(*this));
+}
+
+// Implementacija funkcije add
+void StatsSketch::add(const Settlement& result) {
+    players = result.playerCount > players ? result.playerCount : players;
+    ++games;
+    if (result.tie()) {
+        ++ties;
+    }
+    else {
+        ++wins[result.winner];
+    }
+    for (size_t p = 0; p < result.playerCount; ++p) {
+        int score = result.scores[p];
+        scoreSum[p] += score;
+        scoreSquares[p] += static_cast<uint64_t>(static_cast<int64_t>(score) * score);
+        ++scoreHistogram[scoreBin(score)];
+    }
+    ++winnerHistogram[scoreBin(result.scores[result.winner])];
+}
+
+// Implementacija funkcije addDuel
+void StatsSketch::addDuel(const Settlement& result, size_t seatA) {
+    add(result);
+    if (!result.tie()) {
+        if (result.winner == seatA) {
+            ++duelWins;
+        }
+        else {
+            ++duelLosses;
+        }
+    }
+}
+
+// Implementacija funkcije addDeal
+void StatsSketch::addDeal(unsigned halfPoints) {
+    ++dealScores[halfPoints < DEAL_BINS ? halfPoints : DEAL_BINS - 1];
+}
+
+// Implementacija funkcije deals
+uint64_t StatsSketch::deals() const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < DEAL_BINS; ++i) {
+        total += dealScores[i];
+    }
+    return total;
+}
+
+// Implementacija funkcije merge
+void StatsSketch::merge(const StatsSketch& other) {
+    players = other.players > players ? other.players : players;
+    games += other.games;
+    ties += other.ties;
+    for (size_t p = 0; p < MAX_PLAYERS; ++p) {
+        wins[p] += other.wins[p];
+        scoreSum[p] += other.scoreSum[p];
+        scoreSquares[p] += other.scoreSquares[p];
+    }
+    for (size_t i = 0; i < SCORE_BINS; ++i) {
+        scoreHistogram[i] += other.scoreHistogram[i];
+        winnerHistogram[i] += other.winnerHistogram[i];
+    }
+    duelWins += other.duelWins;
+    duelLosses += other.duelLosses;
+    for (size_t i = 0; i < DEAL_BINS; ++i) {
+        dealScores[i] += other.dealScores[i];
+    }
+}
+
+// Implementacija funkcije meanScore
+double StatsSketch::meanScore(size_t player) const {
+    return games ? static_cast<double>(scoreSum[player]) / static_cast<double>(games) : 0.0;
+}
+
+// Implementacija funkcije scoreDeviation
+double StatsSketch::scoreDeviation(size_t player) const {
+    if (games < 2) {
+        return 0.0;
+    }
+    double mean = meanScore(player);
+    double variance = (static_cast<double>(scoreSquares[player]) - mean * mean * static_cast<double>(games)) /
+        static_cast<double>(games - 1);
+    return variance > 0.0 ? sqrt(variance) : 0.0;
+}
+
+// Implementacija funkcije histogramQuantile
+int histogramQuantile(const uint64_t* histogram, size_t bins, double q) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < bins; ++i) {
+        total += histogram[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    double target = q * static_cast<double>(total);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < bins; ++i) {
+        seen += histogram[i];
+        if (static_cast<double>(seen) >= target && seen > 0) {
+            return static_cast<int>(i);
+        }
+    }
+    return static_cast<int>(bins - 1);
+}
+
+// Implementacija funkcije wilsonInterval
+void wilsonInterval(uint64_t successes, uint64_t trials, double z, double& low, double& high) {
+    if (trials == 0) {
+        low = 0.0;
+        high = 1.0;
+        return;
+    }
+    double n = static_cast<double>(trials);
+    double p = static_cast<double>(successes) / n;
+    double z2 = z * z;
+    double center = (p + z2 / (2.0 * n)) / (1.0 + z2 / n);
+    double margin = z * sqrt(p * (1.0 - p) / n + z2 / (4.0 * n * n)) / (1.0 + z2 / n);
+    low = center - margin < 0.0 ? 0.0 : center - margin;
+    high = center + margin > 1.0 ? 1.0 : center + margin;
+}
+
+// Implementacija funkcije duelHalfPoints
+unsigned duelHalfPoints(const Settlement& result, size_t seatA) {
+    if ((result.tiedMask >> seatA & 1u) == 0) {
+        return 0;
+    }
+    return result.tie() ? 1u : 2u;
+}
+
+// Implementacija funkcije decide (Waldove granice log((1 - beta) / alpha) i log(beta / (1 - alpha)))
+// Rezultat dijeljenja je udio polubodova h / (2 * gamesPerDeal); log omjer je
+// n (p1 - p0) (2 x - p0 - p1) / (2 var) uz srednju vrijednost x i varijancu var dijeljenja.
+// Svaki razred dobiva 1e-3 pseudo-dijeljenja pa varijanca nije nula kad su sva dijeljenja jednaka.
+SprtDecision SprtTest::decide(const uint64_t* dealScores, size_t gamesPerDeal, double& llr) const {
+    const double PSEUDO_DEALS = 1e-3;
+    if (gamesPerDeal == 0) {
+        llr = 0.0;
+        return SPRT_CONTINUE;
+    }
+    size_t bins = 2 * gamesPerDeal + 1;
+    double n = 0.0;
+    double sum = 0.0;
+    double squares = 0.0;
+    for (size_t h = 0; h < bins; ++h) {
+        double count = static_cast<double>(dealScores[h]) + PSEUDO_DEALS;
+        double x = static_cast<double>(h) / static_cast<double>(bins - 1);
+        n += count;
+        sum += count * x;
+        squares += count * x * x;
+    }
+    double mean = sum / n;
+    double variance = squares / n - mean * mean;
+    llr = variance > 0.0 ? n * (p1 - p0) * (2.0 * mean - p0 - p1) / (2.0 * variance) : 0.0;
+    if (llr >= log((1.0 - beta) / alpha)) {
+        return SPRT_ACCEPT_H1;
+    }
+    if (llr <= log(beta / (1.0 - alpha))) {
+        return SPRT_ACCEPT_H0;
+    }
+    return SPRT_CONTINUE;
+}
+
+// Implementacija konstruktora klase LiveStats (samo prazni pokazivači, utore zauzimaju radnici)
+LiveStats::LiveStats(size_t workers) : slots(new atomic<Slot*>[workers]), count(workers) {
+    for (size_t i = 0; i < count; ++i) {
+        slots[i].store(nullptr);
+    }
+}
+
+// Implementacija destruktora klase LiveStats
+LiveStats::~LiveStats() {
+    for (size_t i = 0; i < count; ++i) {
+        delete slots[i].load();
+    }
+}
+
+// Implementacija funkcije attach (poziva je radnik nakon vezanja na procesor)
+void LiveStats::attach(size_t worker) {
+    Slot* slot = new Slot;
+    slot->sketch.clear();
+    slots[worker].store(slot, memory_order_release);
+}
+
+// Implementacija funkcije publish
+void LiveStats::publish(size_t worker, const StatsSketch& delta) {
+    Slot* slot = slots[worker].load(memory_order_acquire);
+    lock_guard<mutex> guard(slot->lock);
+    slot->sketch.merge(delta);
+}
+
+// Implementacija funkcije snapshot
+void LiveStats::snapshot(StatsSketch& total) const {
+    total.clear();
+    for (size_t i = 0; i < count; ++i) {
+        const Slot* slot = slots[i].load(memory_order_acquire);
+        if (slot == nullptr) {
+            continue;
+        }
+        lock_guard<mutex> guard(slot->lock);
+        total.merge(slot->sketch);
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef LIVESTATS_H
+#define LIVESTATS_H
+
+#include "settlement.h"
+#include <cstddef>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+// Sažetak ishoda igara fiksne veličine: brojači, zbrojevi i histogrami koji se zbrajaju pa se
+// sažeci radnika spajaju bez gubitka, a memorija ne raste s brojem igara.
+struct StatsSketch {
+    static const size_t MAX_PLAYERS = Settlement::MAX_PLAYERS;
+    static const size_t SCORE_BINS = 256;  // zadnji razred skuplja sve veće rezultate
+    static const size_t DEAL_BINS = 2 * MAX_PLAYERS + 1;
+
+    uint64_t games;
+    uint64_t ties;
+    uint64_t wins[MAX_PLAYERS];
+    int64_t scoreSum[MAX_PLAYERS];
+    uint64_t scoreSquares[MAX_PLAYERS];
+    uint64_t scoreHistogram[SCORE_BINS];
+    uint64_t winnerHistogram[SCORE_BINS];
+    uint64_t duelWins;    // odlučene igre dvoboja koje je dobio evaluator A
+    uint64_t duelLosses;  // odlučene igre dvoboja koje je dobio neki drugi evaluator
+    // Dijeljenja dvoboja po zbroju polubodova A kroz sve rasporede mjesta (duelHalfPoints); za dva
+    // igrača to je pentanomna razdioba 0..4
+    uint64_t dealScores[DEAL_BINS];
+    uint8_t players;
+
+    void clear();
+    void add(const Settlement& result);
+    // Igra dvoboja u kojoj evaluator A sjedi na mjestu seatA
+    void addDuel(const Settlement& result, size_t seatA);
+    // Cijelo dijeljenje dvoboja, odigrano jednom za svako mjesto evaluatora A
+    void addDeal(unsigned halfPoints);
+    uint64_t deals() const;
+    void merge(const StatsSketch& other);
+    double meanScore(size_t player) const;
+    double scoreDeviation(size_t player) const;
+};
+
+// Rezultat iz histograma za kvantil q (0..1)
+int histogramQuantile(const uint64_t* histogram, size_t bins, double q);
+
+// Wilsonov interval pouzdanosti za udio successes / trials; z = 1.96 daje 95 %
+void wilsonInterval(uint64_t successes, uint64_t trials, double z, double& low, double& high);
+
+// Polubodovi evaluatora A u jednoj igri dvoboja: 2 za pobjedu, 1 za dijeljenu pobjedu, inače 0
+unsigned duelHalfPoints(const Settlement& result, size_t seatA);
+
+// Sekvencijalni test omjera vjerojatnosti (SPRT) za očekivani rezultat A po igri (pobjeda 1, dijeljena
+// pobjeda 1/2): H0 p = p0 protiv H1 p = p1 uz pogreške alpha i beta. Igre istog dijeljenja u raznim
+// rasporedima mjesta su korelirane, pa je jedan ishod cijelo dijeljenje (StatsSketch::dealScores), a
+// log omjer je normalna aproksimacija (GSPRT) s varijancom izmjerenom na dijeljenjima. Granice su zato
+// približne, ali ne pretpostavljaju neovisne igre. Ovisi samo o brojačima pa radi nad spojenim sažecima.
+enum SprtDecision { SPRT_CONTINUE, SPRT_ACCEPT_H0, SPRT_ACCEPT_H1 };
+
+struct SprtTest {
+    double p0;
+    double p1;
+    double alpha;
+    double beta;
+
+    SprtDecision decide(const uint64_t* dealScores, size_t gamesPerDeal, double& llr) const;
+};
+
+// Sažeci po radniku: radnik spaja svoj dio nakon svakog komada igara, izvjestitelj periodički
+// uzima zbroj. Svaki radnik ima svoj utor i bravu pa se radnici međusobno ne čekaju.
+// Utor zauzima sam radnik (attach, nakon vezanja na procesor) pa ga prvi dodir smješta u memoriju
+// njegova čvora; izvjestitelj preskače utore koji još nisu zauzeti.
+class LiveStats {
+public:
+    explicit LiveStats(size_t workers);
+    ~LiveStats();
+    LiveStats(const LiveStats&) = delete;
+    LiveStats& operator=(const LiveStats&) = delete;
+
+    void attach(size_t worker);
+    void publish(size_t worker, const StatsSketch& delta);
+    void snapshot(StatsSketch& total) const;
+
+private:
+    struct alignas(64) Slot {
+        mutable std::mutex lock;
+        StatsSketch sketch;
+    };
+
+    std::unique_ptr<std::atomic<Slot*>[]> slots;
+    size_t count;
+};
+
+#endif
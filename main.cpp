@@ -0,0 +1,24 @@
+﻿#include "rummy.h"
+#include "profiler.h"
+#include <cstring>
+
+int main(int argc, char* argv[]) {
+    // Kreirajte Remi igru sa 2 igrača
+    RummyGame game(2);
+
+    // --ansi: ruka se crta na vrhu ekrana i osvježavaju se samo promijenjene ćelije
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--ansi") == 0) {
+            game.setAnsiOutput(true);
+        }
+    }
+
+    // Počnite igru
+    game.playGame();
+
+    if (PROFILING_ENABLED) {
+        exportChromeTrace("rummy_trace.json");
+    }
+
+    return 0;
+}
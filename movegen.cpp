@@ -0,0 +1,226 @@
+#include "movegen.h"
+#include "canonical.h"
+#include <cstring>
+
+using namespace std;
+
+namespace {
+
+void addSetMoves(CardMask hand, int handSize, MoveList& list) {
+    // Potez smije staviti na stol samo ako igraču ostaje karta za odbacivanje
+    for (int rank = 0; rank < NUM_RANKS; ++rank) {
+        unsigned suits = 0;
+        for (int suit = 0; suit < NUM_SUITS; ++suit) {
+            if (hand & cardBit(suit * NUM_RANKS + rank)) {
+                suits |= 1u << suit;
+            }
+        }
+
+        int count = popCount(suits);
+        if (count == 3 && handSize > 3) {
+            list.add(makeMeldSet(rank, suits));
+        }
+        else if (count == 4) {
+            if (handSize > 4) {
+                list.add(makeMeldSet(rank, suits));
+            }
+            for (int suit = 0; suit < NUM_SUITS; ++suit) {
+                list.add(makeMeldSet(rank, suits & ~(1u << suit)));
+            }
+        }
+    }
+}
+
+// Nizovi kao u collectMelds (deadwood.cpp): od svakog ranga dok karte postoje i runFits dopušta
+void addRunMoves(CardMask hand, int handSize, const RuleSet& rules, MoveList& list) {
+    for (int suit = 0; suit < NUM_SUITS; ++suit) {
+        CardMask row = (hand >> (suit * NUM_RANKS)) & SUIT_ROW_MASK;
+        for (int low = 0; low < NUM_RANKS; ++low) {
+            int length = 0;
+            while (length < NUM_RANKS && (row & (1ULL << ((low + length) % NUM_RANKS)))) {
+                ++length;
+                if (length >= 3) {
+                    if (!runFits(rules, low, length)) {
+                        break;
+                    }
+                    if (length < handSize) {
+                        list.add(makeMeldRun(suit, low, length));
+                    }
+                }
+            }
+        }
+    }
+}
+
+}
+
+// Implementacija funkcije meldMoveMask
+CardMask meldMoveMask(Move move) {
+    if (moveType(move) == MELD_SET) {
+        int rank = static_cast<int>((move >> 4) & 0xF);
+        unsigned suits = (move >> 8) & 0xF;
+        CardMask mask = 0;
+        for (int suit = 0; suit < NUM_SUITS; ++suit) {
+            if (suits & (1u << suit)) {
+                mask |= cardBit(suit * NUM_RANKS + rank);
+            }
+        }
+        return mask;
+    }
+
+    int suit = static_cast<int>((move >> 4) & 0x3);
+    int low = static_cast<int>((move >> 6) & 0xF);
+    int length = static_cast<int>((move >> 10) & 0xF);
+    return runRow(low, length) << (suit * NUM_RANKS);
+}
+
+// Implementacija funkcije generateMoves
+void generateMoves(const GameState& state, MoveList& list) {
+    if (state.isTerminal()) {
+        return;
+    }
+
+    if (state.phase == GameState::DRAW) {
+        list.add(makeDrawStock());
+        if (state.discardCount > 0) {
+            list.add(makeDrawDiscard());
+        }
+        return;
+    }
+
+    CardMask hand = state.hands[state.current];
+    int handSize = popCount(hand);
+
+    // Odbacivanje završava potez; karta uzeta s hrpe ne smije se odmah vratiti
+    for (CardMask bits = hand; bits; bits &= bits - 1) {
+        int card = lowestCard(bits);
+        if (card != state.takenDiscard) {
+            list.add(makeDiscard(card));
+        }
+    }
+
+    addSetMoves(hand, handSize, list);
+    addRunMoves(hand, handSize, ruleSet(static_cast<RuleVariant>(state.variant)), list);
+
+    // Brzo odbacivanje: ako nijedna karta iz ruke ne produžuje nijedan meld, petlja se preskače
+    if (handSize > 1 && state.layoffs.candidates(hand)) {
+        for (uint8_t meld = 0; meld < state.meldCount; ++meld) {
+            for (CardMask bits = state.layoffs.extensions[meld] & hand; bits; bits &= bits - 1) {
+                list.add(makeLayOff(lowestCard(bits), meld));
+            }
+        }
+    }
+}
+
+// Implementacija funkcije makeMove
+void makeMove(GameState& state, Move move, MoveUndo& undo) {
+    RuleVariant variant = static_cast<RuleVariant>(state.variant);
+    undo.move = move;
+    undo.card = GameState::NO_CARD;
+    undo.phase = state.phase;
+    undo.current = state.current;
+    undo.takenDiscard = state.takenDiscard;
+    memcpy(undo.suitKeys, state.suitKeys, sizeof(undo.suitKeys));
+
+    // Zobrist ključevi mijenjaju se samo za karte koje potez pomiče
+    uint64_t* keys = state.suitKeys;
+    if (state.takenDiscard != GameState::NO_CARD) {
+        toggleCardKey(keys, ZOBRIST_TAKEN, 0, state.takenDiscard);
+    }
+    CardMask& hand = state.hands[state.current];
+    switch (moveType(move)) {
+    case DRAW_STOCK:
+        undo.card = state.stock[--state.stockCount];
+        hand |= cardBit(undo.card);
+        toggleCardKey(keys, ZOBRIST_STOCK, state.stockCount, undo.card);
+        toggleCardKey(keys, ZOBRIST_HAND, state.current, undo.card);
+        state.phase = GameState::PLAY;
+        state.takenDiscard = GameState::NO_CARD;
+        break;
+    case DRAW_DISCARD:
+        undo.card = state.discards[--state.discardCount];
+        hand |= cardBit(undo.card);
+        toggleCardKey(keys, ZOBRIST_DISCARD, state.discardCount, undo.card);
+        toggleCardKey(keys, ZOBRIST_HAND, state.current, undo.card);
+        state.phase = GameState::PLAY;
+        state.takenDiscard = undo.card;
+        break;
+    case DISCARD:
+        hand &= ~cardBit(moveCard(move));
+        toggleCardKey(keys, ZOBRIST_HAND, state.current, moveCard(move));
+        toggleCardKey(keys, ZOBRIST_DISCARD, state.discardCount, moveCard(move));
+        state.discards[state.discardCount++] = static_cast<uint8_t>(moveCard(move));
+        state.current = static_cast<uint8_t>((state.current + 1) % state.numPlayers);
+        state.phase = GameState::DRAW;
+        state.takenDiscard = GameState::NO_CARD;
+        break;
+    case MELD_SET:
+    case MELD_RUN: {
+        CardMask meld = meldMoveMask(move);
+        hand &= ~meld;
+        for (CardMask bits = meld; bits; bits &= bits - 1) {
+            toggleCardKey(keys, ZOBRIST_HAND, state.current, lowestCard(bits));
+        }
+        toggleMeldKeys(keys, meld, state.current);
+        state.melds[state.meldCount] = meld;
+        state.meldOwner[state.meldCount] = state.current;
+        state.layoffs.setExtensions(state.meldCount, meldExtensions(meld, variant));
+        ++state.meldCount;
+        break;
+    }
+    case LAY_OFF: {
+        CardMask& meld = state.melds[moveMeldIndex(move)];
+        int owner = state.meldOwner[moveMeldIndex(move)];
+        hand &= ~cardBit(moveCard(move));
+        toggleCardKey(keys, ZOBRIST_HAND, state.current, moveCard(move));
+        // Dodana karta mijenja samo redak svoje boje
+        toggleMeldRowKey(keys, meld, owner, moveCard(move) / NUM_RANKS);
+        meld |= cardBit(moveCard(move));
+        toggleMeldRowKey(keys, meld, owner, moveCard(move) / NUM_RANKS);
+        state.layoffs.setExtensions(moveMeldIndex(move), meldExtensions(meld, variant));
+        break;
+    }
+    }
+    if (state.takenDiscard != GameState::NO_CARD) {
+        toggleCardKey(keys, ZOBRIST_TAKEN, 0, state.takenDiscard);
+    }
+}
+
+// Implementacija funkcije unmakeMove
+void unmakeMove(GameState& state, const MoveUndo& undo) {
+    RuleVariant variant = static_cast<RuleVariant>(state.variant);
+    Move move = undo.move;
+    CardMask& hand = state.hands[undo.current];
+    switch (moveType(move)) {
+    case DRAW_STOCK:
+        hand &= ~cardBit(undo.card);
+        state.stock[state.stockCount++] = undo.card;
+        break;
+    case DRAW_DISCARD:
+        hand &= ~cardBit(undo.card);
+        state.discards[state.discardCount++] = undo.card;
+        break;
+    case DISCARD:
+        --state.discardCount;
+        hand |= cardBit(moveCard(move));
+        break;
+    case MELD_SET:
+    case MELD_RUN:
+        --state.meldCount;
+        hand |= state.melds[state.meldCount];
+        state.layoffs.setExtensions(state.meldCount, 0);
+        break;
+    case LAY_OFF: {
+        CardMask& meld = state.melds[moveMeldIndex(move)];
+        meld &= ~cardBit(moveCard(move));
+        hand |= cardBit(moveCard(move));
+        state.layoffs.setExtensions(moveMeldIndex(move), meldExtensions(meld, variant));
+        break;
+    }
+    }
+
+    state.phase = undo.phase;
+    state.current = undo.current;
+    state.takenDiscard = undo.takenDiscard;
+    memcpy(state.suitKeys, undo.suitKeys, sizeof(state.suitKeys));
+}
@@ -0,0 +1,65 @@
+#ifndef MOVEGEN_H
+#define MOVEGEN_H
+
+#include "gamestate.h"
+#include "layoff.h"
+#include <cstdint>
+
+// Potez je pakiran u 32 bita:
+//   bitovi 0-3   vrsta poteza
+//   DISCARD, LAY_OFF: bitovi 4-9 karta, LAY_OFF: bitovi 10-14 indeks melda
+//   MELD_SET: bitovi 4-7 rang (0..12), bitovi 8-11 maska boja
+//   MELD_RUN: bitovi 4-5 boja, bitovi 6-9 rang početka, bitovi 10-13 duljina (iza kralja slijedi as, runRow)
+typedef uint32_t Move;
+
+enum MoveType : uint32_t { DRAW_STOCK, DRAW_DISCARD, DISCARD, MELD_SET, MELD_RUN, LAY_OFF };
+
+inline MoveType moveType(Move move) { return static_cast<MoveType>(move & 0xF); }
+inline int moveCard(Move move) { return static_cast<int>((move >> 4) & 0x3F); }
+inline int moveMeldIndex(Move move) { return static_cast<int>((move >> 10) & 0x1F); }
+
+inline Move makeDrawStock() { return DRAW_STOCK; }
+inline Move makeDrawDiscard() { return DRAW_DISCARD; }
+inline Move makeDiscard(int card) { return DISCARD | (static_cast<uint32_t>(card) << 4); }
+inline Move makeLayOff(int card, int meld) {
+    return LAY_OFF | (static_cast<uint32_t>(card) << 4) | (static_cast<uint32_t>(meld) << 10);
+}
+inline Move makeMeldSet(int rank, unsigned suits) {
+    return MELD_SET | (static_cast<uint32_t>(rank) << 4) | (static_cast<uint32_t>(suits) << 8);
+}
+inline Move makeMeldRun(int suit, int low, int length) {
+    return MELD_RUN | (static_cast<uint32_t>(suit) << 4) | (static_cast<uint32_t>(low) << 6) |
+        (static_cast<uint32_t>(length) << 10);
+}
+
+// Karte koje potez stavlja na stol (za MELD_SET i MELD_RUN)
+CardMask meldMoveMask(Move move);
+
+// Lista poteza fiksnog kapaciteta na stogu, bez alokacija
+struct MoveList {
+    static const size_t MAX_MOVES = 512;
+
+    Move moves[MAX_MOVES];
+    size_t count;
+
+    MoveList() : count(0) {}
+    void add(Move move) { moves[count++] = move; }
+    size_t size() const { return count; }
+    Move operator[](size_t i) const { return moves[i]; }
+};
+
+// Podaci potrebni za vraćanje poteza
+struct MoveUndo {
+    uint64_t suitKeys[NUM_SUITS];
+    Move move;
+    uint8_t card;
+    uint8_t phase;
+    uint8_t current;
+    uint8_t takenDiscard;
+};
+
+void generateMoves(const GameState& state, MoveList& list);
+void makeMove(GameState& state, Move move, MoveUndo& undo);
+void unmakeMove(GameState& state, const MoveUndo& undo);
+
+#endif
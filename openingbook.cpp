@@ -0,0 +1,179 @@
+#include "openingbook.h"
+#include "canonical.h"
+#include <cstring>
+#include <fstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const char BOOK_MAGIC[4] = { 'R', 'M', 'O', 'B' };
+const uint32_t BOOK_VERSION = 1;
+const int DISCARD_SHIFT = NUM_CARDS;
+
+struct BookHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t slotCount;
+    uint64_t entryCount;
+};
+
+size_t slotIndex(CardMask hand, uint64_t slotMask) {
+    return static_cast<size_t>(mix64(hand) & slotMask);
+}
+
+// Provjera zaglavlja i duljine; slotCount mora biti potencija broja 2
+bool validHeader(const BookHeader& header, size_t fileSize) {
+    return memcmp(header.magic, BOOK_MAGIC, 4) == 0 && header.version == BOOK_VERSION &&
+        header.slotCount != 0 && (header.slotCount & (header.slotCount - 1)) == 0 &&
+        fileSize == sizeof(BookHeader) + header.slotCount * sizeof(uint64_t);
+}
+
+}
+
+// Implementacija konstruktora klase OpeningBook (datoteka se otvara tek pri prvom upitu)
+OpeningBook::OpeningBook(const string& path)
+    : path(path), slots(nullptr), slotMask(0), entryCount(0), mapping(nullptr), mappingSize(0) {
+}
+
+// Implementacija destruktora klase OpeningBook
+OpeningBook::~OpeningBook() {
+#ifndef _WIN32
+    if (mapping) {
+        munmap(mapping, mappingSize);
+    }
+#endif
+}
+
+// Implementacija funkcije load
+void OpeningBook::load() const {
+    BookHeader header;
+#ifdef _WIN32
+    // Bez mmap-a: tablica se učitava u memoriju
+    ifstream in(path, ios::binary | ios::ate);
+    if (!in) {
+        return;
+    }
+    size_t fileSize = static_cast<size_t>(in.tellg());
+    in.seekg(0);
+    if (fileSize < sizeof(header) || !in.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        !validHeader(header, fileSize)) {
+        return;
+    }
+    fallback.resize(static_cast<size_t>(header.slotCount));
+    if (!in.read(reinterpret_cast<char*>(fallback.data()), static_cast<streamsize>(fallback.size() * sizeof(uint64_t)))) {
+        fallback.clear();
+        return;
+    }
+    slots = fallback.data();
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(header)) {
+        close(fd);
+        return;
+    }
+    size_t fileSize = static_cast<size_t>(info.st_size);
+    void* data = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (!validHeader(header, fileSize)) {
+        munmap(data, fileSize);
+        return;
+    }
+    mapping = data;
+    mappingSize = fileSize;
+    slots = reinterpret_cast<const uint64_t*>(static_cast<const char*>(data) + sizeof(header));
+#endif
+    slotMask = header.slotCount - 1;
+    entryCount = static_cast<size_t>(header.entryCount);
+}
+
+// Implementacija funkcije lookup (ruka i karta su u stvarnim bojama)
+bool OpeningBook::lookup(CardMask hand, int& discard) const {
+    call_once(loadFlag, [this]() { load(); });
+    if (!slots || popCount(hand) != HAND_SIZE) {
+        return false;
+    }
+
+    uint8_t perm[NUM_SUITS];
+    CardMask canonical = canonicalHand(hand, perm);
+    size_t i = slotIndex(canonical, slotMask);
+    for (uint64_t probes = 0; probes <= slotMask; ++probes, i = (i + 1) & slotMask) {
+        uint64_t slot = slots[i];
+        if (slot == 0) {
+            return false;
+        }
+        if ((slot & FULL_DECK_MASK) == canonical) {
+            // Karta se vraća iz kanonskih boja inverznom permutacijom
+            int card = static_cast<int>(slot >> DISCARD_SHIFT);
+            int suit = card / NUM_RANKS;
+            for (int s = 0; s < NUM_SUITS; ++s) {
+                if (perm[s] == suit) {
+                    discard = s * NUM_RANKS + card % NUM_RANKS;
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+    return false;
+}
+
+// Implementacija funkcije loaded
+bool OpeningBook::loaded() const {
+    call_once(loadFlag, [this]() { load(); });
+    return slots != nullptr;
+}
+
+// Implementacija funkcije size (broj zapisa)
+size_t OpeningBook::size() const {
+    return loaded() ? entryCount : 0;
+}
+
+// Implementacija funkcije write
+bool OpeningBook::write(const string& path, const vector<Entry>& entries) {
+    // Popunjenost najviše 50% drži lanac linearnog traženja kratkim
+    uint64_t slotCount = 1;
+    while (slotCount < entries.size() * 2) {
+        slotCount *= 2;
+    }
+    vector<uint64_t> table(static_cast<size_t>(slotCount), 0);
+    uint64_t entryCount = 0;
+    for (const Entry& entry : entries) {
+        size_t i = slotIndex(entry.hand, slotCount - 1);
+        while (table[i] != 0 && (table[i] & FULL_DECK_MASK) != entry.hand) {
+            i = (i + 1) & (slotCount - 1);
+        }
+        if (table[i] == 0) {
+            table[i] = entry.hand | (static_cast<uint64_t>(entry.discard) << DISCARD_SHIFT);
+            ++entryCount;
+        }
+    }
+
+    ofstream out(path, ios::binary);
+    if (!out) {
+        return false;
+    }
+    BookHeader header;
+    memcpy(header.magic, BOOK_MAGIC, 4);
+    header.version = BOOK_VERSION;
+    header.slotCount = slotCount;
+    header.entryCount = entryCount;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(table.data()), static_cast<streamsize>(table.size() * sizeof(uint64_t)));
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,48 @@
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include "cardmask.h"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Knjiga otvaranja: za kanonsku ruku od 11 karata (nakon prvog vučenja) čuva preporučeno
+// odbacivanje. Datoteka je otvorena hash tablica zapisa od 8 bajtova koja se mapira u memoriju
+// pri prvom upitu, pa pretraga čita jedan do dva zapisa bez ikakvog parsiranja.
+class OpeningBook {
+public:
+    static const int HAND_SIZE = 11;
+
+    // U datoteci je zapis jedna riječ: bitovi 0-51 kanonska ruka, bitovi 52-57 karta; 0 je prazno mjesto
+    struct Entry {
+        CardMask hand;
+        uint8_t discard;
+    };
+
+    explicit OpeningBook(const std::string& path);
+    ~OpeningBook();
+    OpeningBook(const OpeningBook&) = delete;
+    OpeningBook& operator=(const OpeningBook&) = delete;
+
+    bool lookup(CardMask hand, int& discard) const;
+    bool loaded() const;
+    size_t size() const;
+
+    // Zapisi su u kanonskim bojama; duplikati se spajaju (ostaje prvi)
+    static bool write(const std::string& path, const std::vector<Entry>& entries);
+
+private:
+    std::string path;
+    mutable std::once_flag loadFlag;
+    mutable const uint64_t* slots;
+    mutable uint64_t slotMask;
+    mutable size_t entryCount;
+    mutable void* mapping;
+    mutable size_t mappingSize;
+    mutable std::vector<uint64_t> fallback;
+
+    void load() const;
+};
+
+#endif
@@ -0,0 +1,430 @@
+#include "rummy.h"
+#include "arena.h"
+#include "canonical.h"
+#include "movegen.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Perft: broji sva stanja dostupna do dubine N iz špila zadanog sjemenom.
+// Služi kao provjera generatora poteza i make/unmake te kao mjerilo brzine.
+// S --tree se stablo gradi u areni (SearchTree) i provjerava se i prenošenje podstabla.
+// --verify-hash u svakom čvoru provjerava inkrementalne ključeve i neovisnost hasha o permutaciji boja.
+
+namespace {
+
+struct PerftReference {
+    unsigned seed;
+    int depth;
+    uint64_t nodes;
+};
+
+// Referentne vrijednosti za 2 igrača; promjena pravila ili generatora mora ih obnoviti
+const PerftReference REFERENCE[] = {
+    { 1, 4, 243 },
+    { 1, 6, 5061 },
+    { 1, 8, 111647 },
+    { 1, 10, 2317154 },
+    { 7, 6, 5215 },
+    { 7, 8, 119547 },
+};
+
+// Provjera hashiranja ide do ove dubine za svako sjeme (svaki čvor se provjerava za sve 24 permutacije)
+const unsigned HASH_SEEDS[] = { 1, 7 };
+const int HASH_DEPTH = 8;
+
+// Dijeljena tablica bez zaključavanja: provjera = ključ XOR podatak, pa poderani zapis ne prolazi provjeru
+class PerftTable {
+public:
+    explicit PerftTable(size_t megabytes) : mask(0) {
+        size_t count = 1;
+        while (count * 2 * sizeof(Entry) <= megabytes * 1024 * 1024) {
+            count *= 2;
+        }
+        if (megabytes > 0) {
+            entries.reset(new Entry[count]);
+            mask = count - 1;
+        }
+    }
+
+    bool probe(uint64_t key, int depth, uint64_t& nodes) const {
+        if (!entries) {
+            return false;
+        }
+        const Entry& entry = entries[key & mask];
+        uint64_t data = entry.data.load(memory_order_relaxed);
+        uint64_t check = entry.check.load(memory_order_relaxed);
+        if ((check ^ data) != key || static_cast<int>(data & 0xFF) != depth) {
+            return false;
+        }
+        nodes = data >> 8;
+        return true;
+    }
+
+    void store(uint64_t key, int depth, uint64_t nodes) {
+        if (!entries) {
+            return;
+        }
+        Entry& entry = entries[key & mask];
+        uint64_t data = (nodes << 8) | static_cast<uint64_t>(depth);
+        entry.check.store(key ^ data, memory_order_relaxed);
+        entry.data.store(data, memory_order_relaxed);
+    }
+
+private:
+    struct Entry {
+        atomic<uint64_t> check{ 0 };
+        atomic<uint64_t> data{ 0 };
+    };
+
+    unique_ptr<Entry[]> entries;
+    size_t mask;
+};
+
+uint64_t perft(GameState& state, int depth, PerftTable& table) {
+    if (depth == 0) {
+        return 1;
+    }
+
+    MoveList list;
+    generateMoves(state, list);
+    if (depth == 1) {
+        return list.size();
+    }
+
+    // Ključ se održava inkrementalno u makeMove; redoslijed meldova i permutacija boja ga ne mijenjaju
+    uint64_t key = canonicalStateHash(state);
+    uint64_t nodes = 0;
+    if (table.probe(key, depth, nodes)) {
+        return nodes;
+    }
+
+    for (size_t i = 0; i < list.size(); ++i) {
+        MoveUndo undo;
+        makeMove(state, list[i], undo);
+        nodes += perft(state, depth - 1, table);
+        unmakeMove(state, undo);
+    }
+
+    table.store(key, depth, nodes);
+    return nodes;
+}
+
+// Gradi cijelo stablo do dubine u areni i broji listove; false kad stablo ne stane u zadani broj čvorova
+bool buildTree(GameState& state, SearchNode* node, int depth, SearchTree& tree, uint64_t& leaves) {
+    if (depth == 0) {
+        ++leaves;
+        return true;
+    }
+
+    MoveList list;
+    generateMoves(state, list);
+    if (!tree.expand(node, list.moves, list.size())) {
+        return false;
+    }
+    for (size_t i = 0; i < list.size(); ++i) {
+        MoveUndo undo;
+        makeMove(state, list[i], undo);
+        bool ok = buildTree(state, &node->children[i], depth - 1, tree, leaves);
+        unmakeMove(state, undo);
+        if (!ok) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t countLeaves(const SearchNode& node, int depth) {
+    if (depth == 0) {
+        return 1;
+    }
+    uint64_t leaves = 0;
+    for (uint16_t i = 0; i < node.childCount; ++i) {
+        leaves += countLeaves(node.children[i], depth - 1);
+    }
+    return leaves;
+}
+
+// Stablo do dubine u areni; nakon brojanja korijen prelazi u prvi potez i preneseno podstablo
+// mora imati jednako listova kao prije prijenosa
+bool runTreePerft(unsigned seed, int depth, size_t maxNodes, uint64_t& nodes, double& seconds) {
+    GameState root = RummyGame(2, seed).toState();
+    SearchTree tree(maxNodes);
+
+    auto start = chrono::steady_clock::now();
+    nodes = 0;
+    if (!buildTree(root, tree.root(), depth, tree, nodes)) {
+        cout << "tree exceeds " << maxNodes << " nodes\n";
+        return false;
+    }
+    seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if (depth > 0 && tree.root()->childCount > 0) {
+        size_t before = tree.nodeCount();
+        uint64_t subtreeLeaves = countLeaves(tree.root()->children[0], depth - 1);
+        if (!tree.advance(0) || countLeaves(*tree.root(), depth - 1) != subtreeLeaves || tree.nodeCount() > before) {
+            cout << "subtree recycling failed\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Karta boje s prelazi u boju perm[s]
+uint8_t permuteCard(uint8_t card, const uint8_t* perm) {
+    return static_cast<uint8_t>(perm[card / NUM_RANKS] * NUM_RANKS + card % NUM_RANKS);
+}
+
+// Kopija stanja s preslikanim bojama; zbrojevi ključeva računaju se iznova
+GameState permuteState(const GameState& state, const uint8_t* perm) {
+    GameState permuted = state;
+    for (uint8_t player = 0; player < state.numPlayers; ++player) {
+        permuted.hands[player] = permuteMask(state.hands[player], perm);
+    }
+    for (uint8_t i = 0; i < state.meldCount; ++i) {
+        permuted.melds[i] = permuteMask(state.melds[i], perm);
+    }
+    for (uint8_t i = 0; i < state.stockCount; ++i) {
+        permuted.stock[i] = permuteCard(state.stock[i], perm);
+    }
+    for (uint8_t i = 0; i < state.discardCount; ++i) {
+        permuted.discards[i] = permuteCard(state.discards[i], perm);
+    }
+    if (state.takenDiscard != GameState::NO_CARD) {
+        permuted.takenDiscard = permuteCard(state.takenDiscard, perm);
+    }
+    computeSuitKeys(permuted, permuted.suitKeys);
+    return permuted;
+}
+
+// Obilazak do dubine: u svakom čvoru inkrementalni zbrojevi jednaki su punom izračunu (i nakon unmakeMove
+// djece), a kanonski hash stanja i ruku ne mijenja se ni za jednu permutaciju boja
+bool verifyHashing(GameState& state, int depth, uint64_t& nodes) {
+    ++nodes;
+    uint64_t keys[NUM_SUITS];
+    computeSuitKeys(state, keys);
+    if (memcmp(keys, state.suitKeys, sizeof(keys)) != 0) {
+        cout << "incremental suit keys differ from full computation\n";
+        return false;
+    }
+
+    uint64_t hash = canonicalStateHash(state);
+    uint64_t handHashes[GameState::MAX_PLAYERS];
+    for (uint8_t player = 0; player < state.numPlayers; ++player) {
+        handHashes[player] = canonicalHandHash(state.hands[player]);
+    }
+    for (int index = 0; index < 64; ++index) {
+        // Boje prvih triju mjesta iz indeksa, četvrta je preostala; ponavljanja se preskaču
+        uint8_t perm[NUM_SUITS] = { uint8_t(index & 3), uint8_t(index >> 2 & 3), uint8_t(index >> 4), 0 };
+        perm[3] = static_cast<uint8_t>(6 - perm[0] - perm[1] - perm[2]);
+        if (perm[0] == perm[1] || perm[0] == perm[2] || perm[1] == perm[2]) {
+            continue;
+        }
+        bool same = canonicalStateHash(permuteState(state, perm)) == hash;
+        for (uint8_t player = 0; player < state.numPlayers; ++player) {
+            same = same && canonicalHandHash(permuteMask(state.hands[player], perm)) == handHashes[player];
+        }
+        if (!same) {
+            cout << "canonical hash changes under suit permutation " << int(perm[0]) << int(perm[1])
+                << int(perm[2]) << int(perm[3]) << "\n";
+            return false;
+        }
+    }
+
+    if (depth == 0) {
+        return true;
+    }
+    MoveList list;
+    generateMoves(state, list);
+    for (size_t i = 0; i < list.size(); ++i) {
+        MoveUndo undo;
+        makeMove(state, list[i], undo);
+        bool ok = verifyHashing(state, depth - 1, nodes);
+        unmakeMove(state, undo);
+        if (!ok) {
+            return false;
+        }
+    }
+    if (memcmp(keys, state.suitKeys, sizeof(keys)) != 0) {
+        cout << "suit keys not restored by unmakeMove\n";
+        return false;
+    }
+    return true;
+}
+
+// Korijenski potezi se dijele dretvama preko atomskog brojača
+uint64_t perftRoot(const GameState& root, int depth, size_t threadCount, PerftTable& table, bool divide) {
+    MoveList list;
+    generateMoves(root, list);
+    if (depth <= 1) {
+        return depth == 0 ? 1 : list.size();
+    }
+
+    vector<uint64_t> counts(list.size(), 0);
+    atomic<size_t> next(0);
+    auto worker = [&]() {
+        GameState state = root;
+        for (size_t i = next++; i < list.size(); i = next++) {
+            MoveUndo undo;
+            makeMove(state, list[i], undo);
+            counts[i] = perft(state, depth - 1, table);
+            unmakeMove(state, undo);
+        }
+    };
+
+    vector<thread> threads;
+    for (size_t t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    uint64_t total = 0;
+    for (size_t i = 0; i < list.size(); ++i) {
+        if (divide) {
+            cout << "move " << i << " (0x" << hex << list[i] << dec << "): " << counts[i] << "\n";
+        }
+        total += counts[i];
+    }
+    return total;
+}
+
+uint64_t runPerft(unsigned seed, int depth, size_t threadCount, size_t hashMegabytes, bool divide, double& seconds) {
+    GameState root = RummyGame(2, seed).toState();
+    PerftTable table(hashMegabytes);
+
+    auto start = chrono::steady_clock::now();
+    uint64_t nodes = perftRoot(root, depth, threadCount, table, divide);
+    seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return nodes;
+}
+
+void printUsage() {
+    cout << "Usage: rummy_perft <depth> [seed] [-t threads] [-m hashMB] [--divide]\n"
+        "       rummy_perft --verify [-t threads] [-m hashMB]\n"
+        "       rummy_perft <depth> [seed] --tree [-m treeMB]\n"
+        "       rummy_perft --verify --tree [-m treeMB]\n"
+        "       rummy_perft --verify-hash\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    int depth = -1;
+    unsigned seed = 1;
+    size_t threadCount = 1;
+    size_t hashMegabytes = 64;
+    bool divide = false;
+    bool verify = false;
+    bool treeMode = false;
+    bool verifyHash = false;
+    int positional = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-t" && i + 1 < argc) {
+            threadCount = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-m" && i + 1 < argc) {
+            hashMegabytes = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--divide") {
+            divide = true;
+        }
+        else if (arg == "--verify") {
+            verify = true;
+        }
+        else if (arg == "--tree") {
+            treeMode = true;
+        }
+        else if (arg == "--verify-hash") {
+            verifyHash = true;
+        }
+        else if (positional == 0) {
+            depth = atoi(argv[i]);
+            ++positional;
+        }
+        else if (positional == 1) {
+            seed = static_cast<unsigned>(strtoul(argv[i], nullptr, 10));
+            ++positional;
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (threadCount == 0) {
+        threadCount = thread::hardware_concurrency() ? thread::hardware_concurrency() : 1;
+    }
+
+    // Broj čvorova stabla određuje -m; arena se zauzima dvaput (aktivna i rezervna za prijenos)
+    size_t treeNodes = hashMegabytes * 1024 * 1024 / sizeof(SearchNode);
+
+    if (verifyHash) {
+        bool ok = true;
+        for (unsigned hashSeed : HASH_SEEDS) {
+            GameState root = RummyGame(2, hashSeed).toState();
+            uint64_t nodes = 0;
+            bool match = verifyHashing(root, HASH_DEPTH, nodes);
+            ok = ok && match;
+            cout << "hash seed " << hashSeed << " depth " << HASH_DEPTH << ": " << nodes << " nodes"
+                << (match ? " ok" : " FAILED") << "\n";
+        }
+        return ok ? 0 : 1;
+    }
+
+    if (verify) {
+        bool ok = true;
+        for (const auto& reference : REFERENCE) {
+            double seconds = 0.0;
+            uint64_t nodes = 0;
+            if (treeMode) {
+                // Duboke reference ne stanu u stablo zadane veličine
+                if (reference.nodes > treeNodes / 2) {
+                    continue;
+                }
+                if (!runTreePerft(reference.seed, reference.depth, treeNodes, nodes, seconds)) {
+                    return 1;
+                }
+            }
+            else {
+                nodes = runPerft(reference.seed, reference.depth, threadCount, hashMegabytes, false, seconds);
+            }
+            bool match = nodes == reference.nodes;
+            ok = ok && match;
+            cout << "seed " << reference.seed << " depth " << reference.depth << ": " << nodes
+                << (match ? " ok" : " MISMATCH (expected " + to_string(reference.nodes) + ")") << "\n";
+        }
+        return ok ? 0 : 1;
+    }
+
+    if (depth < 0) {
+        printUsage();
+        return 1;
+    }
+
+    double seconds = 0.0;
+    uint64_t nodes = 0;
+    if (treeMode) {
+        if (!runTreePerft(seed, depth, treeNodes, nodes, seconds)) {
+            return 1;
+        }
+    }
+    else {
+        nodes = runPerft(seed, depth, threadCount, hashMegabytes, divide, seconds);
+    }
+    cout << "nodes " << nodes << "\n"
+        << "time " << seconds << " s\n"
+        << "nps " << static_cast<uint64_t>(seconds > 0.0 ? nodes / seconds : 0.0) << "\n";
+    return 0;
+}
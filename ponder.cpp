@@ -0,0 +1,70 @@
+#include "ponder.h"
+
+using namespace std;
+
+// Implementacija konstruktora klase Ponderer
+Ponderer::Ponderer() : stop(false), ponderedHand(0), ponderedDiscards(0), hitCount(0), missCount(0) {
+    for (auto& flag : ready) {
+        flag.store(false, memory_order_relaxed);
+    }
+}
+
+// Implementacija destruktora klase Ponderer
+Ponderer::~Ponderer() {
+    cancel();
+}
+
+// Implementacija funkcije start
+// hand i discarded su stanje bota prije poteza čovjeka; upcards su karte koje čovjek može odbaciti
+void Ponderer::start(CardMask hand, CardMask discarded, CardMask upcards, Search search) {
+    cancel();
+    for (auto& flag : ready) {
+        flag.store(false, memory_order_relaxed);
+    }
+    ponderedHand = hand;
+    ponderedDiscards = discarded;
+    stop.store(false, memory_order_relaxed);
+
+    worker = thread([this, upcards, search]() {
+        for (CardMask bits = upcards; bits && !stop.load(memory_order_relaxed); bits &= bits - 1) {
+            int upcard = lowestCard(bits);
+            search(upcard, replies[upcard]);
+            // Objava odgovora: zapis u replies vidljiv je prije zastavice
+            ready[upcard].store(true, memory_order_release);
+        }
+    });
+}
+
+// Implementacija funkcije take (false znači da odgovor treba izračunati odmah)
+bool Ponderer::take(CardMask hand, CardMask discarded, int upcard, PonderReply& reply) {
+    // Dretva se zaustavlja prije čitanja da ne troši jezgru dok bot igra
+    cancel();
+    bool hit = hand == ponderedHand && discarded == (ponderedDiscards | cardBit(upcard)) &&
+        ready[upcard].load(memory_order_acquire);
+    if (hit) {
+        reply = replies[upcard];
+        ++hitCount;
+    }
+    else {
+        ++missCount;
+    }
+    return hit;
+}
+
+// Implementacija funkcije cancel
+void Ponderer::cancel() {
+    stop.store(true, memory_order_relaxed);
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+// Implementacija funkcije hits
+size_t Ponderer::hits() const {
+    return hitCount;
+}
+
+// Implementacija funkcije misses
+size_t Ponderer::misses() const {
+    return missCount;
+}
@@ -0,0 +1,46 @@
+#ifndef PONDER_H
+#define PONDER_H
+
+#include "cardmask.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+// Odgovor bota na jednu moguću kartu na vrhu hrpe (upcard) nakon poteza čovjeka
+struct PonderReply {
+    bool takeDiscard;
+    uint8_t discardAfterTake;
+    uint8_t discardAfterDraw[NUM_CARDS];
+};
+
+// Razmišljanje u pozadini: dok čovjek odlučuje, dretva računa odgovor bota za svaku kartu koju
+// čovjek može odbaciti. Kad potez stigne, odgovor se uzima iz tablice ako je izračunat i ako
+// ruka bota i odbačene karte odgovaraju stanju za koje je računat.
+class Ponderer {
+public:
+    typedef std::function<void(int upcard, PonderReply& reply)> Search;
+
+    Ponderer();
+    ~Ponderer();
+    Ponderer(const Ponderer&) = delete;
+    Ponderer& operator=(const Ponderer&) = delete;
+
+    void start(CardMask hand, CardMask discarded, CardMask upcards, Search search);
+    bool take(CardMask hand, CardMask discarded, int upcard, PonderReply& reply);
+    void cancel();
+    size_t hits() const;
+    size_t misses() const;
+
+private:
+    std::thread worker;
+    std::atomic<bool> stop;
+    std::atomic<bool> ready[NUM_CARDS];
+    PonderReply replies[NUM_CARDS];
+    CardMask ponderedHand;
+    CardMask ponderedDiscards;
+    size_t hitCount;
+    size_t missCount;
+};
+
+#endif
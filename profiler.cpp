@@ -0,0 +1,134 @@
+#include "profiler.h"
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+struct ProbeEvent {
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+};
+
+// Prsten po dretvi: najstariji zapisi se prepisuju, snimanje nikad ne alocira
+struct ProbeBuffer {
+    static const size_t CAPACITY = 1 << 14;
+
+    ProbeEvent events[CAPACITY];
+    uint64_t written;
+    size_t threadId;
+};
+
+struct ProbeRegistry {
+    mutex lock;
+    vector<unique_ptr<ProbeBuffer>> buffers;
+    uint64_t startCycles;
+    chrono::steady_clock::time_point startTime;
+
+    ProbeRegistry() : startCycles(readCycles()), startTime(chrono::steady_clock::now()) {}
+};
+
+ProbeRegistry& registry() {
+    static ProbeRegistry instance;
+    return instance;
+}
+
+// Početna točka vremenske crte postavlja se prije main, prije prve sonde
+const bool REGISTRY_READY = (registry(), true);
+
+// Spremnici žive do kraja programa kako bi izvoz radio i nakon završetka dretve
+ProbeBuffer& threadBuffer() {
+    thread_local ProbeBuffer* buffer = nullptr;
+    if (!buffer) {
+        ProbeRegistry& reg = registry();
+        lock_guard<mutex> guard(reg.lock);
+        reg.buffers.emplace_back(new ProbeBuffer());
+        buffer = reg.buffers.back().get();
+        buffer->written = 0;
+        buffer->threadId = reg.buffers.size();
+    }
+    return *buffer;
+}
+
+void writeJsonString(ofstream& out, const char* text) {
+    out << '"';
+    for (const char* p = text; *p; ++p) {
+        if (*p == '"' || *p == '\\') {
+            out << '\\';
+        }
+        out << *p;
+    }
+    out << '"';
+}
+
+}
+
+// Implementacija funkcije readCycles (rdtsc na x86, inače nanosekunde)
+uint64_t readCycles() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+// Implementacija funkcije recordProbe
+void recordProbe(const char* name, uint64_t start, uint64_t end) {
+    ProbeBuffer& buffer = threadBuffer();
+    buffer.events[buffer.written % ProbeBuffer::CAPACITY] = { name, start, end };
+    ++buffer.written;
+}
+
+// Implementacija funkcije resetProbes
+void resetProbes() {
+    ProbeRegistry& reg = registry();
+    lock_guard<mutex> guard(reg.lock);
+    for (auto& buffer : reg.buffers) {
+        buffer->written = 0;
+    }
+}
+
+// Implementacija funkcije exportChromeTrace (format "trace event" s vremenima u mikrosekundama)
+bool exportChromeTrace(const string& path) {
+    ofstream out(path);
+    if (!out) {
+        return false;
+    }
+
+    ProbeRegistry& reg = registry();
+    lock_guard<mutex> guard(reg.lock);
+
+    // Kalibracija ciklusa prema stvarnom vremenu proteklom od prvog korištenja
+    double elapsedMicros = chrono::duration<double, micro>(chrono::steady_clock::now() - reg.startTime).count();
+    uint64_t elapsedCycles = readCycles() - reg.startCycles;
+    double microsPerCycle = (elapsedCycles > 0 && elapsedMicros > 0.0) ? elapsedMicros / static_cast<double>(elapsedCycles) : 0.0;
+
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& buffer : reg.buffers) {
+        uint64_t count = buffer->written < ProbeBuffer::CAPACITY ? buffer->written : ProbeBuffer::CAPACITY;
+        for (uint64_t i = buffer->written - count; i < buffer->written; ++i) {
+            const ProbeEvent& event = buffer->events[i % ProbeBuffer::CAPACITY];
+            out << (first ? "\n" : ",\n") << "{\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"ts\":" << static_cast<double>(event.start - reg.startCycles) * microsPerCycle
+                << ",\"dur\":" << static_cast<double>(event.end - event.start) * microsPerCycle << "}";
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
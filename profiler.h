@@ -0,0 +1,46 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstdint>
+#include <string>
+
+// Mjerenje trajanja faza igre. Sonde se uključuju definiranjem RUMMY_PROFILING;
+// bez toga ScopedProbe je prazna klasa i prevoditelj je potpuno uklanja.
+#ifdef RUMMY_PROFILING
+const bool PROFILING_ENABLED = true;
+#else
+const bool PROFILING_ENABLED = false;
+#endif
+
+uint64_t readCycles();
+void recordProbe(const char* name, uint64_t start, uint64_t end);
+bool exportChromeTrace(const std::string& path);
+void resetProbes();
+
+template <bool Enabled>
+class BasicProbe {
+public:
+    explicit BasicProbe(const char* probeName) : name(probeName), start(readCycles()) {}
+    ~BasicProbe() { recordProbe(name, start, readCycles()); }
+
+    BasicProbe(const BasicProbe&) = delete;
+    BasicProbe& operator=(const BasicProbe&) = delete;
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+template <>
+class BasicProbe<false> {
+public:
+    explicit BasicProbe(const char*) {}
+};
+
+typedef BasicProbe<PROFILING_ENABLED> ScopedProbe;
+
+#define RUMMY_PROBE_CONCAT_INNER(a, b) a##b
+#define RUMMY_PROBE_CONCAT(a, b) RUMMY_PROBE_CONCAT_INNER(a, b)
+#define RUMMY_PROBE(name) ScopedProbe RUMMY_PROBE_CONCAT(rummyProbe, __LINE__)(name)
+
+#endif
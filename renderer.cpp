@@ -0,0 +1,212 @@
+#include "renderer.h"
+#include <cstring>
+
+using namespace std;
+
+namespace {
+
+const char* const CARD_ROWS[TerminalRenderer::CARD_HEIGHT] = {
+    " _________ ",
+    "|         |",
+    "|         |",
+    "|         |",
+    "|         |",
+    "|_________|",
+};
+
+// Duljina reda bez praznih znakova na kraju
+size_t trimmedLength(const char* line, size_t length) {
+    while (length > 0 && line[length - 1] == ' ') {
+        --length;
+    }
+    return length;
+}
+
+size_t digitCount(size_t value) {
+    size_t count = 1;
+    while (value >= 10) {
+        value /= 10;
+        ++count;
+    }
+    return count;
+}
+
+// Najveća duljina jednog okvira. Puni ANSI ispis je kursor na vrh i svi redovi s brisanjem do kraja
+// reda i prijelazom; u razlikama je najgore kad se mijenja svaka druga ćelija, jer tada svaka
+// promijenjena ćelija nosi vlastito pozicioniranje kursora ("\x1b[" red ';' stupac 'H'), a na kraju
+// dolazi pomak kursora ispod zadnjeg nacrtanog reda.
+size_t worstCaseOutput(size_t width, size_t height) {
+    size_t position = 4 + digitCount(height + 1) + digitCount(width);
+    size_t full = 3 + height * (width + 4);
+    size_t diff = height * (width + ((width + 1) / 2) * position) + position;
+    return full > diff ? full : diff;
+}
+
+void appendNumber(string& out, size_t value) {
+    char digits[20];
+    size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (count > 0) {
+        out.push_back(digits[--count]);
+    }
+}
+
+}
+
+// Implementacija konstruktora klase TerminalRenderer
+TerminalRenderer::TerminalRenderer(size_t width, size_t height, bool ansi)
+    : columns(width), rows(height), ansiMode(ansi), hasPrevious(false), usedRows(0), shownRows(0),
+    cells(width * height, ' '), previous(width * height, ' ') {
+    output.reserve(worstCaseOutput(width, height));
+}
+
+// Implementacija funkcije clear
+void TerminalRenderer::clear() {
+    memset(cells.data(), ' ', cells.size());
+    usedRows = 0;
+}
+
+// Implementacija funkcije invalidate (sljedeći flush crta cijeli okvir)
+void TerminalRenderer::invalidate() {
+    hasPrevious = false;
+}
+
+// Implementacija funkcije setAnsi (promjena načina crta sljedeći okvir cijeli)
+void TerminalRenderer::setAnsi(bool ansi) {
+    if (ansi != ansiMode) {
+        ansiMode = ansi;
+        hasPrevious = false;
+    }
+}
+
+// Implementacija funkcije drawText (tekst izvan okvira se odsijeca)
+void TerminalRenderer::drawText(size_t row, size_t col, const string& text) {
+    if (row >= rows || col >= columns) {
+        return;
+    }
+    size_t length = text.size() < columns - col ? text.size() : columns - col;
+    memcpy(&cells[row * columns + col], text.data(), length);
+    markRows(row + 1);
+}
+
+// Implementacija funkcije drawCard
+void TerminalRenderer::drawCard(size_t row, size_t col, char rank, char suit) {
+    if (row + CARD_HEIGHT > rows || col + CARD_WIDTH > columns) {
+        return;
+    }
+    for (size_t line = 0; line < CARD_HEIGHT; ++line) {
+        memcpy(&cells[(row + line) * columns + col], CARD_ROWS[line], CARD_WIDTH);
+    }
+    cells[(row + 2) * columns + col + 5] = rank;
+    cells[(row + 3) * columns + col + 5] = suit;
+    markRows(row + CARD_HEIGHT);
+}
+
+// Implementacija funkcije drawCards (karte jedna do druge, s prelaskom u novi red; vraća broj redova)
+size_t TerminalRenderer::drawCards(size_t row, const char* ranks, const char* suits, size_t count) {
+    size_t perLine = (columns + CARD_GAP) / (CARD_WIDTH + CARD_GAP);
+    if (perLine == 0 || count == 0) {
+        return 0;
+    }
+
+    size_t lines = (count + perLine - 1) / perLine;
+    for (size_t i = 0; i < count; ++i) {
+        drawCard(row + (i / perLine) * CARD_HEIGHT, (i % perLine) * (CARD_WIDTH + CARD_GAP), ranks[i], suits[i]);
+    }
+    return lines * CARD_HEIGHT;
+}
+
+// Implementacija funkcije writeFrame (jedno blokirajuće pisanje po okviru)
+void TerminalRenderer::writeFrame(FILE* out) {
+    output.clear();
+    if (ansiMode && hasPrevious) {
+        appendDiff();
+    }
+    else {
+        appendFull();
+    }
+
+    if (!output.empty()) {
+        fwrite(output.data(), 1, output.size(), out);
+        fflush(out);
+    }
+    previous = cells;
+    hasPrevious = true;
+    shownRows = usedRows;
+}
+
+// Implementacija funkcije appendFull (samo redovi do zadnjeg nacrtanog)
+void TerminalRenderer::appendFull() {
+    // U ANSI načinu okvir počinje na vrhu ekrana i svaki red briše stari tekst samo do kraja tog reda;
+    // bez ANSI-ja prazni redovi na dnu okvira se ne šalju
+    size_t lastRow = usedRows;
+    if (ansiMode) {
+        output.append("\x1b[H");
+    }
+    else {
+        while (lastRow > 0 && trimmedLength(&cells[(lastRow - 1) * columns], columns) == 0) {
+            --lastRow;
+        }
+    }
+    for (size_t row = 0; row < lastRow; ++row) {
+        const char* line = &cells[row * columns];
+        output.append(line, trimmedLength(line, columns));
+        if (ansiMode) {
+            output.append("\x1b[K");
+        }
+        output.push_back('\n');
+    }
+}
+
+// Implementacija funkcije appendDiff (pomak kursora pa samo promijenjeni dijelovi reda)
+void TerminalRenderer::appendDiff() {
+    // Redovi koje je prethodni okvir koristio, a ovaj više ne, brišu se kao promijenjene ćelije
+    size_t extent = usedRows > shownRows ? usedRows : shownRows;
+    for (size_t row = 0; row < extent; ++row) {
+        const char* line = &cells[row * columns];
+        const char* before = &previous[row * columns];
+        size_t col = 0;
+        while (col < columns) {
+            if (line[col] == before[col]) {
+                ++col;
+                continue;
+            }
+            size_t end = col + 1;
+            while (end < columns && line[end] != before[end]) {
+                ++end;
+            }
+            output.append("\x1b[");
+            appendNumber(output, row + 1);
+            output.push_back(';');
+            appendNumber(output, col + 1);
+            output.push_back('H');
+            output.append(line + col, end - col);
+            col = end;
+        }
+    }
+    // Kursor u red ispod zadnjeg nacrtanog reda, gdje ga ostavlja i puni ispis; tekst ispod okvira
+    // (npr. zaglavlje poteza) se ne briše
+    output.append("\x1b[");
+    appendNumber(output, usedRows + 1);
+    output.append(";1H");
+}
+
+// Implementacija funkcije markRows (pamti kraj zadnjeg nacrtanog reda)
+void TerminalRenderer::markRows(size_t end) {
+    if (end > usedRows) {
+        usedRows = end;
+    }
+}
+
+// Implementacija funkcije width
+size_t TerminalRenderer::width() const {
+    return columns;
+}
+
+// Implementacija funkcije height
+size_t TerminalRenderer::height() const {
+    return rows;
+}
@@ -0,0 +1,46 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Crtanje u unaprijed alocirani okvir znakova koji se ispisuje jednim pisanjem.
+// U ANSI načinu ispisuju se samo promijenjene ćelije u odnosu na prethodni okvir; okvir tada
+// zauzima vrh ekrana do zadnjeg nacrtanog reda (height() je samo kapacitet). Briše se samo unutar
+// okvira, a kursor nakon ispisa u oba načina stoji na početku reda ispod zadnjeg nacrtanog reda.
+// Ispis je blokirajući (fwrite pa fflush): sporoj vezi šalje se manje bajtova, ali se na nju čeka.
+class TerminalRenderer {
+public:
+    static const size_t CARD_WIDTH = 11;
+    static const size_t CARD_HEIGHT = 6;
+    static const size_t CARD_GAP = 1;
+
+    TerminalRenderer(size_t width, size_t height, bool ansi = false);
+    void clear();
+    void invalidate();
+    void setAnsi(bool ansi);
+    void drawText(size_t row, size_t col, const std::string& text);
+    void drawCard(size_t row, size_t col, char rank, char suit);
+    size_t drawCards(size_t row, const char* ranks, const char* suits, size_t count);
+    void writeFrame(std::FILE* out = stdout);
+    size_t width() const;
+    size_t height() const;
+
+private:
+    size_t columns;
+    size_t rows;
+    bool ansiMode;
+    bool hasPrevious;
+    size_t usedRows;    // redovi do zadnjeg nacrtanog od clear
+    size_t shownRows;   // usedRows prethodnog ispisanog okvira
+    std::vector<char> cells;
+    std::vector<char> previous;
+    std::string output;
+
+    void appendFull();
+    void appendDiff();
+    void markRows(size_t end);
+};
+
+#endif
@@ -0,0 +1,483 @@
+#include "rummy.h"
+#include "batch.h"
+#include "cardcodec.h"
+#include "trace.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Korpus odigranih igara: "record" snima igre skalarnog RummyGame kao nizove 16-bitnih
+// zapisa poteza (trace.h), a "check" ih ponovno igra kroz odabrane motore na više dretvi
+// i ispisuje prvi potez koji se razlikuje. Korpus vrijedi samo uz iste težine evaluatora.
+// "codec" tekstualnim zapisom (cardcodec.h) prevodi podjele i karte poteza iz korpusa tamo i natrag.
+
+namespace {
+
+const char CORPUS_MAGIC[4] = { 'R', 'M', 'R', 'C' };
+// Verzija 2 dodaje varijantu pravila (ranije je korpus uvijek bio gin)
+const uint32_t CORPUS_VERSION = 2;
+
+struct CorpusHeader {
+    char magic[4];
+    uint32_t version;
+    uint8_t numPlayers;
+    uint8_t deckMode;
+    uint8_t variant;
+    uint8_t reserved;
+    uint32_t gameCount;
+};
+
+// Igra u korpusu; potezi su u zajedničkom nizu od first do first + count
+struct GameRecord {
+    unsigned seed;
+    int16_t scores[GameState::MAX_PLAYERS];
+    size_t first;
+    size_t count;
+};
+
+struct Corpus {
+    size_t numPlayers;
+    DeckMode deckMode;
+    RuleVariant variant;
+    vector<GameRecord> games;
+    vector<TraceEvent> events;
+};
+
+// Prvo razilaženje: redni broj igre, poteza (ili -1 za bodove) i opis
+struct Divergence {
+    size_t game;
+    long event;
+    string detail;
+};
+
+void printUsage() {
+    cout << "Usage: rummy_replay record <corpus> [-n games] [-s firstSeed] [-p players] [-w weights] [-t threads]\n"
+        "                           [-r gin|basic|500] [--lazy]\n"
+        "       rummy_replay check <corpus> [-e scalar|batch|all] [-k batchSize] [-w weights] [-t threads]\n"
+        "       rummy_replay codec <corpus> [-w weights]\n";
+}
+
+template <typename T>
+void writeValue(ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(ifstream& in, T& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+bool writeCorpus(const string& path, const Corpus& corpus) {
+    ofstream out(path, ios::binary);
+    if (!out) {
+        return false;
+    }
+    CorpusHeader header = {};
+    memcpy(header.magic, CORPUS_MAGIC, 4);
+    header.version = CORPUS_VERSION;
+    header.numPlayers = static_cast<uint8_t>(corpus.numPlayers);
+    header.deckMode = static_cast<uint8_t>(corpus.deckMode);
+    header.variant = static_cast<uint8_t>(corpus.variant);
+    header.gameCount = static_cast<uint32_t>(corpus.games.size());
+    writeValue(out, header);
+    for (const GameRecord& game : corpus.games) {
+        writeValue(out, static_cast<uint32_t>(game.seed));
+        writeValue(out, static_cast<uint16_t>(game.count));
+        out.write(reinterpret_cast<const char*>(game.scores), sizeof(int16_t) * corpus.numPlayers);
+        out.write(reinterpret_cast<const char*>(&corpus.events[game.first]), sizeof(TraceEvent) * game.count);
+    }
+    return static_cast<bool>(out);
+}
+
+bool readCorpus(const string& path, Corpus& corpus) {
+    ifstream in(path, ios::binary);
+    CorpusHeader header;
+    if (!in || !readValue(in, header) || memcmp(header.magic, CORPUS_MAGIC, 4) != 0 ||
+        header.version != CORPUS_VERSION || header.numPlayers > GameState::MAX_PLAYERS ||
+        header.variant >= NUM_RULE_VARIANTS ||
+        !supportsPlayerCount(ruleSet(static_cast<RuleVariant>(header.variant)), header.numPlayers)) {
+        return false;
+    }
+    corpus.numPlayers = header.numPlayers;
+    corpus.deckMode = header.deckMode ? LAZY : SHUFFLED;
+    corpus.variant = static_cast<RuleVariant>(header.variant);
+    corpus.games.resize(header.gameCount);
+    corpus.events.clear();
+    for (GameRecord& game : corpus.games) {
+        uint32_t seed = 0;
+        uint16_t count = 0;
+        if (!readValue(in, seed) || !readValue(in, count) ||
+            !in.read(reinterpret_cast<char*>(game.scores), sizeof(int16_t) * corpus.numPlayers)) {
+            return false;
+        }
+        game.seed = seed;
+        game.first = corpus.events.size();
+        game.count = count;
+        corpus.events.resize(game.first + count);
+        if (!in.read(reinterpret_cast<char*>(&corpus.events[game.first]), sizeof(TraceEvent) * count)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+string describeEvent(TraceEvent event, size_t player) {
+    string text = "player " + to_string(player + 1) + " drew ";
+    text += formatHand({ cardFromIndex(traceDrawn(event)) });
+    text += traceTookDiscard(event) ? " from the discard pile" : " from the stock";
+    text += ", discarded " + formatHand({ cardFromIndex(traceThrown(event)) });
+    return text;
+}
+
+// Usporedba odigrane igre sa zapisom; true ako se podudaraju
+bool compareGame(const Corpus& corpus, size_t index, const vector<TraceEvent>& events, const int* scores,
+    Divergence& divergence) {
+    const GameRecord& game = corpus.games[index];
+    const TraceEvent* expected = &corpus.events[game.first];
+    size_t common = events.size() < game.count ? events.size() : game.count;
+    for (size_t i = 0; i < common; ++i) {
+        if (events[i] != expected[i]) {
+            size_t player = i % corpus.numPlayers;
+            divergence = { index, static_cast<long>(i),
+                "expected " + describeEvent(expected[i], player) + "; got " + describeEvent(events[i], player) };
+            return false;
+        }
+    }
+    if (events.size() != game.count) {
+        divergence = { index, static_cast<long>(common),
+            "expected " + to_string(game.count) + " turns, got " + to_string(events.size()) };
+        return false;
+    }
+    for (size_t p = 0; p < corpus.numPlayers; ++p) {
+        if (scores[p] != game.scores[p]) {
+            divergence = { index, -1, "player " + to_string(p + 1) + " scored " + to_string(scores[p]) +
+                ", expected " + to_string(game.scores[p]) };
+            return false;
+        }
+    }
+    return true;
+}
+
+// Igre se dijele dretvama u komadima od chunk igara; razilaženje s najmanjim rednim brojem pobjeđuje
+template <typename Work>
+void runParallel(size_t gameCount, size_t chunk, size_t threadCount, Work work) {
+    atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t first = next.fetch_add(chunk); first < gameCount; first = next.fetch_add(chunk)) {
+            work(first, gameCount - first < chunk ? gameCount - first : chunk);
+        }
+    };
+    vector<thread> threads;
+    for (size_t t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+class DivergenceSink {
+public:
+    DivergenceSink() : found(false) {}
+
+    void report(const Divergence& divergence) {
+        lock_guard<mutex> lock(guard);
+        if (!found || divergence.game < first.game) {
+            first = divergence;
+            found = true;
+        }
+    }
+
+    bool get(Divergence& divergence) const {
+        divergence = first;
+        return found;
+    }
+
+private:
+    mutable mutex guard;
+    bool found;
+    Divergence first;
+};
+
+bool checkScalar(const Corpus& corpus, const Evaluator& evaluator, size_t threadCount, Divergence& divergence) {
+    DivergenceSink sink;
+    runParallel(corpus.games.size(), 256, threadCount, [&](size_t first, size_t count) {
+        vector<TraceEvent> events;
+        events.reserve(2 * NUM_CARDS);
+        for (size_t i = first; i < first + count; ++i) {
+            events.clear();
+            RummyGame game(corpus.numPlayers, corpus.games[i].seed, evaluator, corpus.deckMode, corpus.variant);
+            game.setTrace(&events);
+            vector<int> scores = game.simulate();
+            Divergence found;
+            if (!compareGame(corpus, i, events, scores.data(), found)) {
+                sink.report(found);
+                return;
+            }
+        }
+    });
+    return !sink.get(divergence);
+}
+
+bool checkBatch(const Corpus& corpus, const Evaluator& evaluator, size_t batchSize, size_t threadCount,
+    Divergence& divergence) {
+    DivergenceSink sink;
+    runParallel(corpus.games.size(), batchSize, threadCount, [&](size_t first, size_t count) {
+        vector<unsigned> seeds(count);
+        for (size_t k = 0; k < count; ++k) {
+            seeds[k] = corpus.games[first + k].seed;
+        }
+        GameBatch batch(corpus.numPlayers, seeds.data(), count, evaluator, corpus.deckMode, corpus.variant);
+        batch.enableTraces();
+        batch.run();
+        for (size_t k = 0; k < count; ++k) {
+            int scores[GameState::MAX_PLAYERS];
+            for (size_t p = 0; p < corpus.numPlayers; ++p) {
+                scores[p] = batch.score(k, p);
+            }
+            Divergence found;
+            if (!compareGame(corpus, first + k, batch.trace(k), scores, found)) {
+                sink.report(found);
+                return;
+            }
+        }
+    });
+    return !sink.get(divergence);
+}
+
+// Tekstualni zapis igre tamo i natrag: podjela kroz encodeDeal/decodeDeal, ruke kroz formatHand/parseHand
+// i operator<</parseCard, a niz karata poteza kroz encodeCards/decodeCards. Niz poteza smije ponavljati
+// karte, pa ga decodeMask i parseHand moraju odbiti točno kad se neka karta ponovi.
+bool checkCodecGame(const Corpus& corpus, size_t index, const Evaluator& evaluator, string& detail) {
+    const GameRecord& game = corpus.games[index];
+    GameState state = RummyGame(corpus.numPlayers, game.seed, evaluator, corpus.deckMode, corpus.variant).toState();
+
+    char text[4 * NUM_CARDS];
+    size_t length = encodeDeal(state.hands, corpus.numPlayers, text);
+    CardMask hands[GameState::MAX_PLAYERS];
+    size_t handCount = 0;
+    if (!decodeDeal(text, length, hands, GameState::MAX_PLAYERS, handCount) || handCount != corpus.numPlayers ||
+        memcmp(hands, state.hands, sizeof(CardMask) * handCount) != 0) {
+        detail = "deal \"" + string(text, length) + "\" does not decode to the dealt hands";
+        return false;
+    }
+
+    for (size_t p = 0; p < corpus.numPlayers; ++p) {
+        vector<Card> hand;
+        for (CardMask bits = state.hands[p]; bits; bits &= bits - 1) {
+            hand.push_back(cardFromIndex(lowestCard(bits)));
+        }
+        vector<Card> parsed;
+        string formatted = formatHand(hand);
+        if (!parseHand(formatted, parsed) || parsed != hand) {
+            detail = "hand \"" + formatted + "\" does not parse back";
+            return false;
+        }
+        for (const Card& card : hand) {
+            ostringstream printed;
+            printed << card;
+            Card back;
+            if (!parseCard(printed.str(), back) || !(back == card)) {
+                detail = "card \"" + printed.str() + "\" does not parse back";
+                return false;
+            }
+        }
+    }
+
+    vector<uint8_t> cards;
+    CardMask seen = 0;
+    bool repeated = false;
+    for (size_t i = game.first; i < game.first + game.count; ++i) {
+        for (int card : { traceDrawn(corpus.events[i]), traceThrown(corpus.events[i]) }) {
+            repeated = repeated || (seen & cardBit(card)) != 0;
+            seen |= cardBit(card);
+            cards.push_back(static_cast<uint8_t>(card));
+        }
+    }
+    string encoded(3 * cards.size(), ' ');
+    encoded.resize(encodeCards(cards.data(), cards.size(), &encoded[0]));
+    vector<uint8_t> decoded(cards.size());
+    size_t count = 0;
+    if (!decodeCards(encoded.data(), encoded.size(), decoded.data(), decoded.size(), count) || count != cards.size() ||
+        decoded != cards) {
+        detail = "turn cards do not decode back";
+        return false;
+    }
+    CardMask mask = 0;
+    vector<Card> parsed;
+    if (decodeMask(encoded.data(), encoded.size(), mask) == repeated ||
+        parseHand(encoded, parsed) == repeated || (!repeated && mask != seen)) {
+        detail = string("turn cards with") + (repeated ? "" : "out") + " a repeated card decode as a hand";
+        return false;
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printUsage();
+        return 1;
+    }
+    string command = argv[1];
+    string path = argv[2];
+    size_t gameCount = 100000;
+    unsigned firstSeed = 1;
+    size_t numPlayers = 2;
+    size_t batchSize = 256;
+    size_t threadCount = 0;
+    string engine = "all";
+    string weights;
+    DeckMode deckMode = SHUFFLED;
+    RuleVariant variant = GIN_RUMMY;
+
+    for (int i = 3; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc) {
+            gameCount = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-s" && i + 1 < argc) {
+            firstSeed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-p" && i + 1 < argc) {
+            numPlayers = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-k" && i + 1 < argc) {
+            batchSize = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-t" && i + 1 < argc) {
+            threadCount = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-e" && i + 1 < argc) {
+            engine = argv[++i];
+        }
+        else if (arg == "-w" && i + 1 < argc) {
+            weights = argv[++i];
+        }
+        else if (arg == "-r" && i + 1 < argc) {
+            if (!parseRuleVariant(argv[++i], variant)) {
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--lazy") {
+            deckMode = LAZY;
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (threadCount == 0) {
+        threadCount = thread::hardware_concurrency() ? thread::hardware_concurrency() : 1;
+    }
+    if (batchSize == 0 || numPlayers > GameState::MAX_PLAYERS || !supportsPlayerCount(ruleSet(variant), numPlayers)) {
+        printUsage();
+        return 1;
+    }
+
+    Evaluator evaluator;
+    if (!weights.empty() && !evaluator.loadWeights(weights)) {
+        cerr << "Error: cannot load weights from " << weights << "\n";
+        return 1;
+    }
+
+    auto start = chrono::steady_clock::now();
+    if (command == "record") {
+        // Svaka igra se snima u svoj niz pa poredak u korpusu ne ovisi o dretvama
+        vector<vector<TraceEvent>> traces(gameCount);
+        vector<int16_t> scores(gameCount * numPlayers);
+        runParallel(gameCount, 256, threadCount, [&](size_t first, size_t count) {
+            for (size_t i = first; i < first + count; ++i) {
+                RummyGame game(numPlayers, firstSeed + static_cast<unsigned>(i), evaluator, deckMode, variant);
+                game.setTrace(&traces[i]);
+                vector<int> result = game.simulate();
+                for (size_t p = 0; p < numPlayers; ++p) {
+                    scores[i * numPlayers + p] = static_cast<int16_t>(result[p]);
+                }
+            }
+        });
+
+        Corpus corpus;
+        corpus.numPlayers = numPlayers;
+        corpus.deckMode = deckMode;
+        corpus.variant = variant;
+        corpus.games.resize(gameCount);
+        for (size_t i = 0; i < gameCount; ++i) {
+            GameRecord& game = corpus.games[i];
+            game.seed = firstSeed + static_cast<unsigned>(i);
+            memcpy(game.scores, &scores[i * numPlayers], sizeof(int16_t) * numPlayers);
+            game.first = corpus.events.size();
+            game.count = traces[i].size();
+            corpus.events.insert(corpus.events.end(), traces[i].begin(), traces[i].end());
+        }
+        if (!writeCorpus(path, corpus)) {
+            cerr << "Error: cannot write " << path << "\n";
+            return 1;
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "recorded " << gameCount << " games (" << corpus.events.size() << " turns) in " << seconds << " s\n";
+        return 0;
+    }
+
+    if ((command != "check" && command != "codec") || (engine != "scalar" && engine != "batch" && engine != "all")) {
+        printUsage();
+        return 1;
+    }
+    Corpus corpus;
+    if (!readCorpus(path, corpus)) {
+        cerr << "Error: cannot read corpus " << path << "\n";
+        return 1;
+    }
+
+    if (command == "codec") {
+        for (size_t i = 0; i < corpus.games.size(); ++i) {
+            string detail;
+            if (!checkCodecGame(corpus, i, evaluator, detail)) {
+                cout << "codec: MISMATCH in game " << i << " (seed " << corpus.games[i].seed << "): " << detail << "\n";
+                return 1;
+            }
+        }
+        cout << "codec: " << corpus.games.size() << " games round-trip\n";
+        return 0;
+    }
+
+    bool ok = true;
+    for (const string& name : vector<string>{ "scalar", "batch" }) {
+        if (engine != "all" && engine != name) {
+            continue;
+        }
+        auto engineStart = chrono::steady_clock::now();
+        Divergence divergence;
+        bool match = name == "scalar" ? checkScalar(corpus, evaluator, threadCount, divergence)
+            : checkBatch(corpus, evaluator, batchSize, threadCount, divergence);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - engineStart).count();
+        if (match) {
+            cout << name << ": " << corpus.games.size() << " games match in " << seconds << " s, "
+                << static_cast<uint64_t>(corpus.games.size() / seconds) << " games/s\n";
+        }
+        else {
+            const GameRecord& game = corpus.games[divergence.game];
+            cout << name << ": DIVERGED in game " << divergence.game << " (seed " << game.seed << ")";
+            if (divergence.event >= 0) {
+                cout << " at turn " << divergence.event;
+            }
+            cout << ": " << divergence.detail << "\n";
+            ok = false;
+        }
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,107 @@
+#ifndef RULES_H
+#define RULES_H
+
+#include "cardmask.h"
+#include <cstddef>
+
+// Opis pravila varijante remija. Jedan RuleSet se bira pri pokretanju (RummyGame), a isti opis
+// kao StaticRules<V> daje konstante prevođenja, pa se vruće petlje (GameBatch) prevode posebno
+// za svaku varijantu bez provjera pravila u petlji.
+// Varijante se razlikuju veličinom ruke, vrijednostima karata, kucanjem, bonusima i nizovima: as može biti
+// samo nizak (A-2-3), i nizak i visok (Q-K-A), a nizovi mogu ići i preko kralja na asa (K-A-2).
+// Jokera nema jer je špil maska od 52 bita (jedan špil bez dodatnih karata), pa indijski remi
+// (dva špila i jokeri) nije među varijantama.
+enum RuleVariant { GIN_RUMMY, BASIC_RUMMY, RUM_500, NUM_RULE_VARIANTS };
+
+struct RuleSet {
+    const char* name;
+    int handSize;
+    int aceValue;      // kazneni bodovi asa u ruci
+    int faceValue;     // kazneni bodovi dečka, dame i kralja
+    int knockLimit;    // najveći deadwood za kucanje; -1 znači da se izlazi samo bez deadwooda
+    int ginBonus;      // kazna svakom protivniku kad igrač izađe bez deadwooda (gin)
+    int undercutBonus; // kazna igraču koji je kucao kad protivnik ima jednako ili manje deadwooda
+    bool aceHigh;      // as smije biti i iznad kralja (Q-K-A)
+    bool wrapAround;   // nizovi smiju ići preko kralja na asa (K-A-2); uključuje aceHigh
+};
+
+// Redoslijed odgovara RuleVariant
+constexpr RuleSet RULE_SETS[NUM_RULE_VARIANTS] = {
+    { "gin", 10, 1, 10, 10, 25, 25, false, false },
+    { "basic", 10, 1, 10, -1, 0, 0, true, true },
+    { "500", 7, 15, 10, -1, 0, 0, true, false },
+};
+
+constexpr const RuleSet& ruleSet(RuleVariant variant) {
+    return RULE_SETS[variant];
+}
+
+// Kazneni bodovi karte po rangu (0 = as, 12 = kralj)
+constexpr int rankPenalty(const RuleSet& rules, int rank) {
+    return rank == 0 ? rules.aceValue : rank >= 10 ? rules.faceValue : rank + 1;
+}
+
+// Smije li niz od length karata boje početi rangom low (0..12). Pozicije iznad kralja su as
+// (pozicija 13) pa dalje u krug; niz od svih 13 karata broji se jednom, s početkom na asu.
+constexpr bool runFits(const RuleSet& rules, int low, int length) {
+    return length >= 3 && length <= NUM_RANKS && (length < NUM_RANKS || low == 0) &&
+        (rules.wrapAround || low + length <= (rules.aceHigh ? NUM_RANKS + 1 : NUM_RANKS));
+}
+
+// Redak boje (13 bitova) niza od length karata s početkom na rangu low; pozicije iznad kralja prelaze na asa
+constexpr CardMask runRow(int low, int length) {
+    return ((((1ULL << length) - 1) << low) | (((1ULL << length) - 1) >> (NUM_RANKS - low))) & SUIT_ROW_MASK;
+}
+
+// Podjela mora ostaviti barem jednu kartu u špilu (500 sa 7 karata dopušta najviše 7 igrača)
+constexpr bool supportsPlayerCount(const RuleSet& rules, size_t players) {
+    return players >= 2 && players * static_cast<size_t>(rules.handSize) < static_cast<size_t>(NUM_CARDS);
+}
+
+// Varijanta po imenu ("gin", "basic", "500"); false ako ime nije poznato
+inline bool parseRuleVariant(const char* name, RuleVariant& variant) {
+    for (int i = 0; i < NUM_RULE_VARIANTS; ++i) {
+        const char* a = RULE_SETS[i].name;
+        const char* b = name;
+        while (*a && *a == *b) {
+            ++a;
+            ++b;
+        }
+        if (*a == *b) {
+            variant = static_cast<RuleVariant>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+template <RuleVariant V>
+struct StaticRules {
+    static constexpr RuleVariant variant = V;
+    static constexpr int handSize = RULE_SETS[V].handSize;
+    static constexpr int knockLimit = RULE_SETS[V].knockLimit;
+    static constexpr bool aceHigh = RULE_SETS[V].aceHigh;
+    static constexpr bool wrapAround = RULE_SETS[V].wrapAround;
+
+    static constexpr int penalty(int rank) {
+        return rankPenalty(RULE_SETS[V], rank);
+    }
+};
+
+// Poziva visitor sa StaticRules<V> za zadanu varijantu; grananje se događa jednom, izvan petlje
+template <typename Visitor>
+void withRules(RuleVariant variant, Visitor&& visitor) {
+    switch (variant) {
+    case BASIC_RUMMY:
+        visitor(StaticRules<BASIC_RUMMY>());
+        break;
+    case RUM_500:
+        visitor(StaticRules<RUM_500>());
+        break;
+    default:
+        visitor(StaticRules<GIN_RUMMY>());
+        break;
+    }
+}
+
+#endif
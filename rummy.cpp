@@ -1,39 +1,107 @@
 ﻿#include "rummy.h"
+#include "cardcodec.h"
+#include "canonical.h"
+#include "deadwood.h"
+#include "ponder.h"
+#include "profiler.h"
+#include "renderer.h"
+#include "showdown.h"
 #include <algorithm>
-#include <climits>
-#include <random>
+#include <cassert>
+#include <limits>
 #include <chrono>
 
 using namespace std;
 
+namespace {
+
+unsigned clockSeed() {
+    return static_cast<unsigned>(chrono::system_clock::now().time_since_epoch().count());
+}
+
+// Zajednička knjiga otvaranja za igre s datotekama uz program; učitava se pri prvom upitu
+const OpeningBook& defaultOpeningBook() {
+    static OpeningBook book("rummy_book.bin");
+    return book;
+}
+
+}
+
 // Implementacija konstruktora klase Deck
-Deck::Deck() {
+Deck::Deck() : Deck(clockSeed()) {
+}
+
+// Implementacija konstruktora klase Deck sa zadanim sjemenom (ponovljivo miješanje)
+Deck::Deck(unsigned seed) : Deck(seed, SHUFFLED) {
+}
+
+// Implementacija konstruktora klase Deck sa zadanim načinom rada
+// U načinu LAZY špil se ne miješa unaprijed; svako vučenje je jedan korak Fisher-Yatesa
+Deck::Deck(unsigned seed, DeckMode mode) : lazy(mode == LAZY), rng(seed) {
+    cards.reserve(NUM_CARDS);
     for (int suit = static_cast<int>(Suit::HEARTS); suit <= static_cast<int>(Suit::SPADES); ++suit) {
         for (int rank = static_cast<int>(Rank::ACE); rank <= static_cast<int>(Rank::KING); ++rank) {
             cards.push_back({ static_cast<Suit>(suit), static_cast<Rank>(rank) });
         }
     }
-    shuffleDeck();
+    if (!lazy) {
+        shuffleDeck(seed);
+    }
 }
 
 // Implementacija funkcije shuffleDeck
 void Deck::shuffleDeck() {
-    unsigned seed = static_cast<unsigned>(chrono::system_clock::now().time_since_epoch().count());
-    mt19937 generator(seed);
+    shuffleDeck(clockSeed());
+}
 
-    shuffle(cards.begin(), cards.end(), generator);
+// Implementacija funkcije shuffleDeck sa zadanim sjemenom (Fisher-Yates)
+// Generator špila se ponovno sije pa isti koraci kao u načinu LAZY daju isti redoslijed vučenja;
+// punjenje špila s hrpe (refill) nastavlja isti niz
+void Deck::shuffleDeck(unsigned seed) {
+    RUMMY_PROBE("shuffleDeck");
+    rng = FastRng(seed);
+    for (size_t i = cards.size(); i > 1; --i) {
+        swap(cards[i - 1], cards[rng.below(static_cast<uint32_t>(i))]);
+    }
 }
 
-// Implementacija funkcije drawCard
-Card Deck::drawCard() {
-    if (!empty()) {
-        Card drawnCard = cards.back();
-        cards.pop_back();
-        return drawnCard;
+// Implementacija funkcije materialize (dovršava odgođeno miješanje, poredak postaje redoslijed vučenja)
+void Deck::materialize() {
+    if (!lazy) {
+        return;
     }
-    else {
-        cerr << "Error: The deck is empty.\n";
-        exit(EXIT_FAILURE);
+    // Isti koraci kao uzastopna vučenja pa je poredak jednak onome koji bi LAZY vučenje dalo
+    for (size_t i = cards.size(); i > 1; --i) {
+        swap(cards[i - 1], cards[rng.below(static_cast<uint32_t>(i))]);
+    }
+    lazy = false;
+}
+
+// Implementacija funkcije tryDrawCard (prazan špil vraća false, bez prekida programa i iznimki)
+bool Deck::tryDrawCard(Card& card) {
+    if (cards.empty()) {
+        return false;
+    }
+    if (lazy) {
+        // Slučajna preostala karta zamijeni se sa zadnjom pa se zadnja uzima
+        swap(cards.back(), cards[rng.below(static_cast<uint32_t>(cards.size()))]);
+    }
+    card = cards.back();
+    cards.pop_back();
+    return true;
+}
+
+// Implementacija funkcije refill (karte s hrpe vraćaju se u špil i miješaju)
+void Deck::refill(const uint8_t* cardIndices, size_t count) {
+    // Kapacitet je rezerviran za 52 karte pa ovdje nema realokacije
+    size_t first = cards.size();
+    for (size_t i = 0; i < count; ++i) {
+        cards.push_back(cardFromIndex(cardIndices[i]));
+    }
+    if (!lazy) {
+        for (size_t i = cards.size() - first; i > 1; --i) {
+            swap(cards[first + i - 1], cards[first + rng.below(static_cast<uint32_t>(i))]);
+        }
     }
 }
 
@@ -42,103 +110,108 @@ bool Deck::empty() const {
     return cards.empty();
 }
 
-// Implementacija funkcije printDeck
-void Deck::printDeck() const {
-    for (const auto& card : cards) {
-        cout << "[" << getSuitSymbol(card.suit) << getRankSymbol(card.rank) << "] ";
-    }
-    cout << "\n";
+// Implementacija funkcije size
+size_t Deck::size() const {
+    return cards.size();
 }
 
-// Implementacija funkcije getSuitSymbol
-char Deck::getSuitSymbol(Suit suit) const {
-    switch (suit) {
-    case Suit::HEARTS:
-        return 'H';
-    case Suit::DIAMONDS:
-        return 'D';
-    case Suit::CLUBS:
-        return 'C';
-    case Suit::SPADES:
-        return 'S';
-    default:
-        return '?';
-    }
+// Implementacija funkcije remaining (vrh špila je zadnji element; u načinu LAZY poredak nije redoslijed vučenja)
+const vector<Card>& Deck::remaining() const {
+    return cards;
 }
 
-// Implementacija funkcije getRankSymbol
-char Deck::getRankSymbol(Rank rank) const {
-    switch (rank) {
-    case Rank::ACE:
-        return 'A';
-    case Rank::JACK:
-        return 'J';
-    case Rank::QUEEN:
-        return 'Q';
-    case Rank::KING:
-        return 'K';
-    default:
-        return static_cast<char>('0' + static_cast<int>(rank));
+// Implementacija funkcije generator (stanje generatora za nastavak miješanja izvan klase, GameBatch)
+const FastRng& Deck::generator() const {
+    return rng;
+}
+
+// Implementacija funkcije printDeck
+void Deck::printDeck() const {
+    for (const auto& card : cards) {
+        cout << "[" << card << "] ";
     }
+    cout << "\n";
 }
 
 // Implementacija funkcije printHand
 void Player::printHand() const {
     for (size_t i = 0; i < hand.size(); ++i) {
-        cout << "[" << i + 1 << ": " << getSuitSymbol(hand[i].suit) << getRankSymbol(hand[i].rank) << "] ";
+        cout << "[" << i + 1 << ": " << hand[i] << "] ";
     }
     cout << "\n";
 }
 
-// Implementacija funkcije printHandASCII
-void Player::printHandASCII() const {
-    for (size_t i = 0; i < hand.size(); ++i) {
-        cout << " _________\n";
-        cout << "|         |\n";
-        cout << "|    " << getRankSymbol(hand[i].rank) << "    |\n";
-        cout << "|    " << getSuitSymbol(hand[i].suit) << "    |\n";
-        cout << "|         |\n";
-        cout << "|_________|\n";
+// Implementacija funkcije printHandASCII (u ANSI načinu ponovno se crtaju samo promijenjene ćelije)
+void Player::printHandASCII(bool ansi) const {
+    RUMMY_PROBE("printHandASCII");
+    // Okvir je alociran jednom po dretvi za najveću moguću ruku, a ispisuje se samo do zadnjeg reda
+    // nacrtanih karata (ceil(count / cardsPerLine) * CARD_HEIGHT redova); karte se crtaju jedna do
+    // druge i ispisuju jednim pisanjem
+    const size_t width = 80;
+    const size_t cardsPerLine = (width + TerminalRenderer::CARD_GAP) / (TerminalRenderer::CARD_WIDTH + TerminalRenderer::CARD_GAP);
+    thread_local TerminalRenderer renderer(width, ((NUM_CARDS + cardsPerLine - 1) / cardsPerLine) * TerminalRenderer::CARD_HEIGHT);
+
+    char ranks[NUM_CARDS];
+    char suits[NUM_CARDS];
+    size_t count = hand.size() < static_cast<size_t>(NUM_CARDS) ? hand.size() : static_cast<size_t>(NUM_CARDS);
+    for (size_t i = 0; i < count; ++i) {
+        ranks[i] = getRankSymbol(hand[i].rank);
+        suits[i] = getSuitSymbol(hand[i].suit);
     }
+
+    renderer.setAnsi(ansi);
+    renderer.clear();
+    renderer.drawCards(0, ranks, suits, count);
+    renderer.writeFrame();
     cout << "\n";
 }
 
 // Implementacija funkcije drawCard za igrača
-Card Player::drawCard(Deck& deck) {
+bool Player::drawCard(Deck& deck, Card& card) {
     // Uzimanje nove karte
-    Card drawnCard = deck.drawCard();
-    hand.push_back(drawnCard);
+    if (!deck.tryDrawCard(card)) {
+        return false;
+    }
+    hand.push_back(card);
 
-    // Ako igrač ima više od 10 karata, pitajte ga koju kartu želi odbaciti
-    if (hand.size() > 10) {
-        cout << "Your hand has more than 10 cards. Choose a card to discard:\n";
-        printHand();
-
-        int discardIndex;
-        do {
-            cout << "Enter the index of the card to discard (1 to " << hand.size() << "): ";
-            cin >> discardIndex;
-
-            if (cin.fail()) {
-                cin.clear();
-                cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                cout << "Invalid input. Please enter a number.\n";
-                discardIndex = -1;
-            }
-        } while (discardIndex < 1 || discardIndex > static_cast<int>(hand.size()));
+    return true;
+}
 
-        // Odbacivanje odabrane karte
-        discardCard(static_cast<size_t>(discardIndex));
-    }
+// Implementacija funkcije drawFromDiscard
+Card Player::drawFromDiscard(DiscardPile& pile) {
+    // Uzimanje gornje karte sa zajedničke hrpe
+    Card drawnCard = pile.take();
+    hand.push_back(drawnCard);
 
     return drawnCard;
 }
 
+// Implementacija funkcije askDiscardIndex
+size_t Player::askDiscardIndex(size_t handLimit) const {
+    cout << "Your hand has more than " << handLimit << " cards. Choose a card to discard:\n";
+    printHand();
+
+    int discardIndex;
+    do {
+        cout << "Enter the index of the card to discard (1 to " << hand.size() << "): ";
+        cin >> discardIndex;
+
+        if (cin.fail()) {
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            cout << "Invalid input. Please enter a number.\n";
+            discardIndex = -1;
+        }
+    } while (discardIndex < 1 || discardIndex > static_cast<int>(hand.size()));
+
+    return static_cast<size_t>(discardIndex);
+}
+
 // Implementacija funkcije discardCard
-void Player::discardCard(size_t index) {
+void Player::discardCard(size_t index, DiscardPile& pile, size_t seat) {
     if (index >= 1 && index <= hand.size()) {
         Card discardedCard = hand[index - 1];
-        discardPile.push_back(discardedCard);
+        pile.push(discardedCard, seat);
         hand.erase(hand.begin() + index - 1);
     }
     else {
@@ -146,38 +219,6 @@ void Player::discardCard(size_t index) {
     }
 }
 
-// Implementacija funkcije getSuitSymbol za igrača
-char Player::getSuitSymbol(Suit suit) const {
-    switch (suit) {
-    case Suit::HEARTS:
-        return 'H';
-    case Suit::DIAMONDS:
-        return 'D';
-    case Suit::CLUBS:
-        return 'C';
-    case Suit::SPADES:
-        return 'S';
-    default:
-        return '?';
-    }
-}
-
-// Implementacija funkcije getRankSymbol za igrača
-char Player::getRankSymbol(Rank rank) const {
-    switch (rank) {
-    case Rank::ACE:
-        return 'A';
-    case Rank::JACK:
-        return 'J';
-    case Rank::QUEEN:
-        return 'Q';
-    case Rank::KING:
-        return 'K';
-    default:
-        return static_cast<char>('0' + static_cast<int>(rank));
-    }
-}
-
 // Implementacija funkcije hasValidMeld
 bool Player::hasValidMeld() const {
     // Jednostavan primer - proveravamo da li igrač ima bar jednu kartu u meld-u
@@ -190,7 +231,25 @@ void Player::addToMeld(const vector<Card>& meld) {
 }
 
 // Implementacija konstruktora klase RummyGame
-RummyGame::RummyGame(size_t numPlayers) : currentPlayerIndex(0) {
+RummyGame::RummyGame(size_t numPlayers) : RummyGame(numPlayers, clockSeed()) {
+}
+
+// Implementacija konstruktora klase RummyGame sa zadanim sjemenom špila
+RummyGame::RummyGame(size_t numPlayers, unsigned seed) : RummyGame(numPlayers, seed, Evaluator()) {
+    // Naučene težine i knjiga otvaranja su opcionalne, bez datoteka ostaju zadane odluke
+    evaluator.loadWeights("rummy_weights.bin");
+    openingBook = &defaultOpeningBook();
+}
+
+// Implementacija konstruktora klase RummyGame s već učitanim evaluatorom (simulacije)
+RummyGame::RummyGame(size_t numPlayers, unsigned seed, const Evaluator& botEvaluator, DeckMode deckMode,
+    RuleVariant variant)
+    : deck(seed, deckMode), currentPlayerIndex(0), evaluator(botEvaluator), variant(variant),
+    rules(ruleSet(variant)),
+    stockPolicy(END_ON_EMPTY_STOCK), recycleLimit(0), recycles(0), turnCount(0),
+    outSeat(-1), openingBook(nullptr), trace(nullptr), ansiOutput(false) {
+    // Pozivatelj provjerava supportsPlayerCount; podjela cijelog špila ne bi ostavila karte za vučenje
+    assert(supportsPlayerCount(rules, numPlayers));
     for (size_t i = 0; i < numPlayers; ++i) {
         players.push_back(Player());
     }
@@ -200,28 +259,117 @@ RummyGame::RummyGame(size_t numPlayers) : currentPlayerIndex(0) {
 
 // Implementacija funkcije dealInitialHands
 void RummyGame::dealInitialHands() {
+    RUMMY_PROBE("dealInitialHands");
+    Card card;
     for (Player& player : players) {
-        for (int i = 0; i < 10; ++i) {
-            player.drawCard(deck);
+        for (int i = 0; i < rules.handSize; ++i) {
+            if (!player.drawCard(deck, card)) {
+                break;
+            }
+        }
+    }
+
+    // Maske ruku se dalje vode inkrementalno u recordTurn
+    handMasks.clear();
+    for (const Player& player : players) {
+        handMasks.push_back(handMask(player.hand));
+    }
+}
+
+// Implementacija funkcije setStockPolicy
+// Svako punjenje vraća najviše 51 kartu u igru, pa povijest hrpe dobiva mjesta za još jedan prolaz špila
+void RummyGame::setStockPolicy(StockPolicy policy, size_t maxRecycles) {
+    stockPolicy = policy;
+    recycleLimit = maxRecycles;
+    discardPile.setHistoryLimit(NUM_CARDS * (policy == RECYCLE_DISCARDS ? maxRecycles + 1 : 1));
+}
+
+// Implementacija funkcije setOpeningBook (nullptr isključuje knjigu)
+void RummyGame::setOpeningBook(const OpeningBook* book) {
+    openingBook = book;
+}
+
+// Implementacija funkcije setTrace (nullptr isključuje zapisivanje poteza)
+void RummyGame::setTrace(vector<TraceEvent>* events) {
+    trace = events;
+}
+
+// Implementacija funkcije setAnsiOutput
+void RummyGame::setAnsiOutput(bool enabled) {
+    ansiOutput = enabled;
+}
+
+// Implementacija funkcije recordTurn (poziva se nakon odbacivanja, odbačena karta je na vrhu hrpe)
+void RummyGame::recordTurn(const Card& drawnCard, bool tookDiscard) {
+    handMasks[currentPlayerIndex] ^= cardBit(cardIndex(drawnCard)) ^ cardBit(cardIndex(discardPile.top()));
+    if (trace) {
+        trace->push_back(makeTraceEvent(cardIndex(drawnCard), tookDiscard, cardIndex(discardPile.top())));
+    }
+}
+
+// Implementacija funkcije advanceTurn
+// Nakon odbacivanja igrač izlazi ako ruka stane u meldove do granice kucanja; igra tada odmah završava.
+// Provjera nije O(1): donja granica iz meldableCards odbija većinu ruku s nekoliko operacija nad
+// bitovima, a točna pretraga (minDeadwood) pokreće se samo za kandidate
+void RummyGame::advanceTurn() {
+    {
+        RUMMY_PROBE("goOutCheck");
+        if (canGoOut(handMasks[currentPlayerIndex], rules.knockLimit, variant)) {
+            outSeat = static_cast<int>(currentPlayerIndex);
         }
     }
+    ++turnCount;
+    currentPlayerIndex = (currentPlayerIndex + 1) % players.size();
+    replenishStock();
+}
+
+// Implementacija funkcije replenishStock
+// Po pravilima remija prazan špil se puni odbačenim kartama osim gornje; ograničenje broja
+// punjenja sprječava beskonačnu igru kad nitko ne može završiti. Završena igra (netko je izašao)
+// se ne puni, kao ni u GameBatch.
+void RummyGame::replenishStock() {
+    if (outSeat >= 0 || !deck.empty() || stockPolicy != RECYCLE_DISCARDS || recycles >= recycleLimit || discardPile.size() < 2) {
+        return;
+    }
+    uint8_t cards[NUM_CARDS];
+    size_t count = discardPile.takeAllButTop(cards);
+    deck.refill(cards, count);
+    ++recycles;
 }
 
 // Implementacija funkcije playGame
 void RummyGame::playGame() {
+    Ponderer ponderer;
     while (!isGameOver()) {
         Player& currentPlayer = players[currentPlayerIndex];
 
         cout << "\nPlayer " << currentPlayerIndex + 1 << "'s turn:\n";
-        currentPlayer.printHandASCII();
+        currentPlayer.printHandASCII(ansiOutput);
 
         if (currentPlayerIndex == 0) {
+            RUMMY_PROBE("humanTurn");
+
+            // Dok čovjek odlučuje, sljedeći bot u pozadini računa odgovor na svaku moguću odbačenu kartu
+            if (players.size() > 1) {
+                CardMask botHand = handMask(players[1].hand);
+                CardMask discarded = discardPile.discardedMask();
+                bool firstTurn = turnCount + 1 < players.size();
+                ponderer.start(botHand, discarded, FULL_DECK_MASK & ~botHand,
+                    [this, botHand, discarded, firstTurn](int upcard, PonderReply& reply) {
+                        ponderBotReply(botHand, discarded | cardBit(upcard), upcard, firstTurn, reply);
+                    });
+            }
+
             // Korisnički unos za prvog igrača
+            int maxChoice = discardPile.empty() ? 1 : 2;
             cout << "Choose an action:\n"
                 "1. Draw a card\n";
+            if (maxChoice == 2) {
+                cout << "2. Take the top discard [" << discardPile.top() << "]\n";
+            }
             int choice;
             do {
-                cout << "Enter your choice (1): ";
+                cout << "Enter your choice (1-" << maxChoice << "): ";
                 cin >> choice;
 
                 if (cin.fail()) {
@@ -230,93 +378,266 @@ void RummyGame::playGame() {
                     cout << "Invalid input. Please enter a number.\n";
                     choice = -1;
                 }
-            } while (choice != 1);
+            } while (choice < 1 || choice > maxChoice);
 
             // Draw a card
-            Card drawnCard = currentPlayer.drawCard(deck);
-            cout << "Drew Card: [" << deck.getSuitSymbol(drawnCard.suit) << deck.getRankSymbol(drawnCard.rank) << "]\n";
+            Card drawnCard;
+            if (choice == 2) {
+                drawnCard = currentPlayer.drawFromDiscard(discardPile);
+            }
+            else {
+                currentPlayer.drawCard(deck, drawnCard);
+            }
+            cout << "Drew Card: [" << drawnCard << "]\n";
+
+            // Ako igrač ima više karata nego što pravila dopuštaju, pitajte ga koju kartu želi odbaciti
+            size_t handLimit = static_cast<size_t>(rules.handSize);
+            if (currentPlayer.hand.size() > handLimit) {
+                currentPlayer.discardCard(currentPlayer.askDiscardIndex(handLimit), discardPile, currentPlayerIndex);
+            }
+            recordTurn(drawnCard, choice == 2);
         }
         else {
             // Automatski potezi za drugog igrača
-            Card drawnCard = currentPlayer.drawCard(deck);
-            currentPlayer.discardCard(1);
-            cout << "Drew Card: [" << deck.getSuitSymbol(drawnCard.suit) << deck.getRankSymbol(drawnCard.rank) << "]\n";
-            cout << "Discarded Card: [" << deck.getSuitSymbol(currentPlayer.discardPile.back().suit)
-                << deck.getRankSymbol(currentPlayer.discardPile.back().rank) << "]\n";
+            RUMMY_PROBE("botTurn");
+            bool tookDiscard = false;
+            PonderReply reply;
+            bool pondered = currentPlayerIndex == 1 && !discardPile.empty() &&
+                ponderer.take(handMask(currentPlayer.hand), discardPile.discardedMask(), cardIndex(discardPile.top()), reply);
+            Card drawnCard = playBotTurn(currentPlayer, tookDiscard, pondered ? &reply : nullptr);
+            cout << "Drew Card: [" << drawnCard << "]"
+                << (tookDiscard ? " from the discard pile" : "") << "\n";
+            cout << "Discarded Card: [" << discardPile.top() << "]\n";
         }
 
-        currentPlayerIndex = (currentPlayerIndex + 1) % players.size();
+        advanceTurn();
     }
 
     cout << "\nGame over!\n";
+    if (outSeat >= 0) {
+        cout << "Player " << outSeat + 1 << " goes out.\n";
+    }
 
     displayScoresAndWinner();
 }
 
-// Implementacija funkcije calculateScore
-int RummyGame::calculateScore(const Player& player) const {
-    int score = 0;
+// Implementacija funkcije simulate (svi igrači su botovi, bez ispisa)
+vector<int> RummyGame::simulate() {
+    while (!isGameOver()) {
+        bool tookDiscard = false;
+        playBotTurn(players[currentPlayerIndex], tookDiscard);
+        advanceTurn();
+    }
+
+    vector<int> scores(players.size());
+    calculateScores(scores.data());
+    return scores;
+}
+
+// Implementacija funkcije settle (svaki igrač se boduje jednom, bez ispisa)
+Settlement RummyGame::settle() const {
+    vector<int> scores(players.size());
+    calculateScores(scores.data());
+    size_t count = players.size() < Settlement::MAX_PLAYERS ? players.size() : Settlement::MAX_PLAYERS;
+    Settlement result;
+    ::settle(scores.data(), count, result);
+    return result;
+}
 
-    // Bodovanje preostalih karata u ruci
-    for (const auto& card : player.hand) {
-        score += getCardValue(card);
+// Implementacija funkcije turns (broj odigranih poteza)
+size_t RummyGame::turns() const {
+    return turnCount;
+}
+
+// Implementacija funkcije recycleCount (koliko je puta špil napunjen s hrpe)
+size_t RummyGame::recycleCount() const {
+    return recycles;
+}
+
+// Implementacija funkcije cardsConserved
+// Ruke, meldovi na stolu, špil i hrpa zajedno drže svaku od 52 karte točno jednom (i nakon punjenja špila)
+bool RummyGame::cardsConserved() const {
+    CardMask seen = 0;
+    size_t count = 0;
+    for (const Player& player : players) {
+        for (const Card& card : player.hand) {
+            seen |= cardBit(cardIndex(card));
+            ++count;
+        }
+        for (const auto& meld : player.melds) {
+            for (const Card& card : meld) {
+                seen |= cardBit(cardIndex(card));
+                ++count;
+            }
+        }
+    }
+    for (const Card& card : deck.remaining()) {
+        seen |= cardBit(cardIndex(card));
+        ++count;
+    }
+    for (uint8_t card : discardPile.liveCards()) {
+        seen |= cardBit(card);
+        ++count;
     }
+    return seen == FULL_DECK_MASK && count == static_cast<size_t>(NUM_CARDS);
+}
+
+// Implementacija funkcije toState
+GameState RummyGame::toState() const {
+    GameState state = {};
+    state.numPlayers = static_cast<uint8_t>(players.size());
+    state.current = static_cast<uint8_t>(currentPlayerIndex);
+    state.phase = GameState::DRAW;
+    state.takenDiscard = GameState::NO_CARD;
+    state.variant = static_cast<uint8_t>(variant);
+
+    for (size_t i = 0; i < players.size() && i < GameState::MAX_PLAYERS; ++i) {
+        state.hands[i] = handMask(players[i].hand);
+        for (const auto& meld : players[i].melds) {
+            if (state.meldCount < GameState::MAX_MELDS && !meld.empty()) {
+                state.melds[state.meldCount] = handMask(meld);
+                state.meldOwner[state.meldCount] = static_cast<uint8_t>(i);
+                state.layoffs.setExtensions(state.meldCount, meldExtensions(state.melds[state.meldCount], variant));
+                ++state.meldCount;
+            }
+        }
+    }
+
+    // Neodređeni poredak odgođenog špila učvršćuje se na kopiji, s istim nastavkom generatora
+    Deck stock = deck;
+    stock.materialize();
+    for (const auto& card : stock.remaining()) {
+        state.stock[state.stockCount++] = static_cast<uint8_t>(cardIndex(card));
+    }
+    for (uint8_t card : discardPile.liveCards()) {
+        state.discards[state.discardCount++] = card;
+    }
+    computeSuitKeys(state, state.suitKeys);
+    return state;
+}
 
-    // Bodovanje za svaki meld
-    for (const auto& meld : player.melds) {
-        for (const auto& card : meld) {
-            score += getCardValue(card);
+// Implementacija funkcije calculateScores (scores prima po jedan zapis za svakog igrača)
+// Kad je netko izašao, ruke se boduju obračunom s dodavanjem na meldove (scoreShowdown), inače se
+// broje sve karte u ruci; meldovi već položeni na stol broje se uvijek
+void RummyGame::calculateScores(int* scores) const {
+    RUMMY_PROBE("calculateScores");
+    if (outSeat >= 0) {
+        scoreShowdown(handMasks.data(), players.size(), static_cast<size_t>(outSeat), variant, scores);
+    }
+    else {
+        for (size_t i = 0; i < players.size(); ++i) {
+            scores[i] = rawDeadwood(handMasks[i], variant);
         }
     }
 
-    return score;
+    for (size_t i = 0; i < players.size(); ++i) {
+        for (const auto& meld : players[i].melds) {
+            for (const auto& card : meld) {
+                scores[i] += getCardValue(card);
+            }
+        }
+    }
 }
 
 // Implementacija funkcije isGameOver
 bool RummyGame::isGameOver() const {
-    return deck.empty();
+    return outSeat >= 0 || deck.empty();
 }
 
-// Implementacija funkcije displayScoresAndWinner
-void RummyGame::displayScoresAndWinner() const {
-    cout << "\nScores:\n";
-    for (size_t i = 0; i < players.size(); ++i) {
-        cout << "Player " << i + 1 << ": " << calculateScore(players[i]) << " points\n";
+// Implementacija funkcije playBotTurn
+// pondered je odgovor izračunat unaprijed za ovo stanje (Ponderer); bez njega odluka se računa sada
+Card RummyGame::playBotTurn(Player& player, bool& tookDiscard, const PonderReply* pondered) {
+    CardMask discarded = discardPile.discardedMask();
+    bool firstTurn = turnCount < players.size();
+    tookDiscard = false;
+    if (pondered) {
+        tookDiscard = pondered->takeDiscard;
+    }
+    else if (!discardPile.empty()) {
+        tookDiscard = shouldTakeDiscard(handMask(player.hand), discarded, cardIndex(discardPile.top()));
     }
 
-    int winningScore = INT_MAX;
-    size_t winnerIndex = 0;
+    Card drawnCard;
+    if (tookDiscard) {
+        drawnCard = player.drawFromDiscard(discardPile);
+    }
+    else {
+        player.drawCard(deck, drawnCard);
+    }
 
-    for (size_t i = 0; i < players.size(); ++i) {
-        if (calculateScore(players[i]) < winningScore) {
-            winnerIndex = i;
-            winningScore = calculateScore(players[i]);
+    int thrown;
+    if (pondered) {
+        thrown = tookDiscard ? pondered->discardAfterTake : pondered->discardAfterDraw[cardIndex(drawnCard)];
+    }
+    else {
+        thrown = chooseBotDiscard(handMask(player.hand), discarded, firstTurn);
+    }
+    for (size_t i = 0; i < player.hand.size(); ++i) {
+        if (cardIndex(player.hand[i]) == thrown) {
+            player.discardCard(i + 1, discardPile, currentPlayerIndex);
+            break;
         }
     }
+    recordTurn(drawnCard, tookDiscard);
+    return drawnCard;
+}
 
-    cout << "\nPlayer " << winnerIndex + 1 << " wins with " << winningScore << " points!\n";
+// Implementacija funkcije shouldTakeDiscard
+// Gornju kartu hrpe bot uzima samo ako se procjena ruke time poboljšava.
+// GameBatch ponavlja istu odluku nad maskama pa promjene ovdje moraju pratiti batch.cpp
+bool RummyGame::shouldTakeDiscard(CardMask hand, CardMask discarded, int top) const {
+    float bestValue = 0.0f;
+    if (evaluator.bestDiscard(hand | cardBit(top), discarded, bestValue) == top) {
+        return false;
+    }
+    return bestValue > evaluator.evaluate(hand, discarded);
 }
 
-// Implementacija funkcije getCardValue
-int RummyGame::getCardValue(const Card& card) const {
-    switch (card.rank) {
-    case Rank::ACE:
-        return 1;
-    case Rank::JACK:
-    case Rank::QUEEN:
-    case Rank::KING:
-        return 10;
-    default:
-        return static_cast<int>(card.rank);
+// Implementacija funkcije chooseBotDiscard (prvi potez svakog igrača uzima se iz knjige otvaranja ako ruka u njoj postoji)
+int RummyGame::chooseBotDiscard(CardMask hand, CardMask discarded, bool firstTurn) const {
+    int card = -1;
+    if (firstTurn && openingBook && openingBook->lookup(hand, card) && (hand & cardBit(card))) {
+        return card;
     }
+    float bestValue = 0.0f;
+    return evaluator.bestDiscard(hand, discarded, bestValue);
 }
 
-int main() {
-    // Kreirajte Remi igru sa 2 igrača
-    RummyGame game(2);
+// Implementacija funkcije ponderBotReply
+// Odgovor bota za slučaj da čovjek odbaci upcard; poziva se iz pozadinske dretve pa smije
+// čitati samo evaluator i knjigu, a stanje igre dobiva kroz argumente
+void RummyGame::ponderBotReply(CardMask hand, CardMask discarded, int upcard, bool firstTurn, PonderReply& reply) const {
+    reply.takeDiscard = shouldTakeDiscard(hand, discarded, upcard);
+    reply.discardAfterTake = static_cast<uint8_t>(
+        reply.takeDiscard ? chooseBotDiscard(hand | cardBit(upcard), discarded, firstTurn) : GameState::NO_CARD);
+    for (CardMask bits = FULL_DECK_MASK & ~hand & ~cardBit(upcard); bits; bits &= bits - 1) {
+        int card = lowestCard(bits);
+        reply.discardAfterDraw[card] = static_cast<uint8_t>(chooseBotDiscard(hand | cardBit(card), discarded, firstTurn));
+    }
+}
+
+// Implementacija funkcije displayScoresAndWinner
+void RummyGame::displayScoresAndWinner() const {
+    Settlement result = settle();
+    cout << "\nScores:\n";
+    for (size_t i = 0; i < result.playerCount; ++i) {
+        cout << "Player " << i + 1 << ": " << result.scores[i] << " points\n";
+    }
 
-    // Počnite igru
-    game.playGame();
+    if (result.tie()) {
+        cout << "\nTie at " << result.scores[result.winner] << " points between players";
+        for (size_t i = 0; i < result.playerCount; ++i) {
+            if (result.tiedMask & (1u << i)) {
+                cout << " " << i + 1;
+            }
+        }
+        cout << "!\n";
+        return;
+    }
+    cout << "\nPlayer " << result.winner + 1 << " wins with " << result.scores[result.winner] << " points!\n";
+}
 
-    return 0;
-}
\ No newline at end of file
+// Implementacija funkcije getCardValue
+int RummyGame::getCardValue(const Card& card) const {
+    return rankPenalty(rules, static_cast<int>(card.rank) - 1);
+}
@@ -1,52 +1,55 @@
 #ifndef RUMMY_H
 #define RUMMY_H
 
+#include "card.h"
+#include "discardpile.h"
+#include "evaluator.h"
+#include "fastrng.h"
+#include "gamestate.h"
+#include "openingbook.h"
+#include "rules.h"
+#include "settlement.h"
+#include "trace.h"
 #include <iostream>
 #include <vector>
 
-enum Suit { HEARTS, DIAMONDS, CLUBS, SPADES };
-enum Rank { ACE = 1, TWO, THREE, FOUR, FIVE, SIX, SEVEN, EIGHT, NINE, TEN, JACK, QUEEN, KING };
+struct PonderReply;
 
-struct Card {
-    Suit suit;
-    Rank rank;
-
-    bool operator==(const Card& other) const {
-        return suit == other.suit && rank == other.rank;
-    }
-
-    friend std::ostream& operator<<(std::ostream& os, const Card& card);
-};
-
-std::ostream& operator<<(std::ostream& os, const Suit& suit);
-std::ostream& operator<<(std::ostream& os, const Rank& rank);
+enum DeckMode { SHUFFLED, LAZY };
+enum StockPolicy { END_ON_EMPTY_STOCK, RECYCLE_DISCARDS };
 
 class Deck {
 private:
     std::vector<Card> cards;
+    bool lazy;
+    FastRng rng;
 
 public:
     Deck();
+    explicit Deck(unsigned seed);
+    Deck(unsigned seed, DeckMode mode);
     void shuffleDeck();
-    Card drawCard();
+    void shuffleDeck(unsigned seed);
+    void materialize();
+    bool tryDrawCard(Card& card);
+    void refill(const uint8_t* cardIndices, size_t count);
     bool empty() const;
     void printDeck() const;
-    char getSuitSymbol(Suit suit) const;
-    char getRankSymbol(Rank rank) const;
     std::size_t size() const;
+    const std::vector<Card>& remaining() const;
+    const FastRng& generator() const;
 };
 
 struct Player {
     std::vector<Card> hand;
     std::vector<std::vector<Card>> melds;
-    std::vector<Card> discardPile;
 
     void printHand() const;
-    void printHandASCII() const;
-    Card drawCard(Deck& deck);
-    void discardCard(size_t index);
-    char getSuitSymbol(Suit suit) const;
-    char getRankSymbol(Rank rank) const;
+    void printHandASCII(bool ansi = false) const;
+    bool drawCard(Deck& deck, Card& card);
+    Card drawFromDiscard(DiscardPile& pile);
+    size_t askDiscardIndex(size_t handLimit) const;
+    void discardCard(size_t index, DiscardPile& pile, size_t seat);
     bool hasValidMeld() const;
     void addToMeld(const std::vector<Card>& meld);
 
@@ -56,18 +59,51 @@ struct Player {
 class RummyGame {
 private:
     Deck deck;
+    DiscardPile discardPile;
     std::vector<Player> players;
     size_t currentPlayerIndex;
+    Evaluator evaluator;
+    RuleVariant variant;
+    RuleSet rules;
+    StockPolicy stockPolicy;
+    size_t recycleLimit;
+    size_t recycles;
+    size_t turnCount;
+    std::vector<CardMask> handMasks;
+    int outSeat;
+    const OpeningBook* openingBook;
+    std::vector<TraceEvent>* trace;
+    bool ansiOutput;
 
 public:
     RummyGame(size_t numPlayers);
+    RummyGame(size_t numPlayers, unsigned seed);
+    RummyGame(size_t numPlayers, unsigned seed, const Evaluator& botEvaluator, DeckMode deckMode = SHUFFLED,
+        RuleVariant variant = GIN_RUMMY);
     void dealInitialHands();
+    void setStockPolicy(StockPolicy policy, size_t maxRecycles);
+    void setOpeningBook(const OpeningBook* book);
+    void setTrace(std::vector<TraceEvent>* events);
+    void setAnsiOutput(bool enabled);
     void playGame();
+    std::vector<int> simulate();
+    Settlement settle() const;
+    size_t turns() const;
+    size_t recycleCount() const;
+    bool cardsConserved() const;
+    GameState toState() const;
 
 private:
     bool isGameOver() const;
+    void replenishStock();
+    void advanceTurn();
+    void recordTurn(const Card& drawnCard, bool tookDiscard);
+    Card playBotTurn(Player& player, bool& tookDiscard, const PonderReply* pondered = nullptr);
+    bool shouldTakeDiscard(CardMask hand, CardMask discarded, int top) const;
+    int chooseBotDiscard(CardMask hand, CardMask discarded, bool firstTurn) const;
+    void ponderBotReply(CardMask hand, CardMask discarded, int upcard, bool firstTurn, PonderReply& reply) const;
     void displayScoresAndWinner() const;
-    int calculateScore(const Player& player) const;
+    void calculateScores(int* scores) const;
     int getCardValue(const Card& card) const;
 };
 
@@ -0,0 +1,71 @@
+#include "settlement.h"
+#include "cardmask.h"
+
+using namespace std;
+
+namespace {
+
+// Igre se obrađuju u blokovima: petlje po igrama unutar bloka nemaju grananja pa ih prevoditelj vektorizira
+const size_t SETTLE_BLOCK = 256;
+
+}
+
+// Implementacija funkcije settle (neovisna o settleBatch pa služi kao njezina referenca)
+void settle(const int* scores, size_t playerCount, Settlement& out) {
+    size_t players = playerCount < Settlement::MAX_PLAYERS ? playerCount : Settlement::MAX_PLAYERS;
+    out.playerCount = static_cast<uint8_t>(players);
+    out.winner = 0;
+    out.tiedMask = 0;
+    for (size_t p = 0; p < players; ++p) {
+        out.scores[p] = scores[p];
+        if (scores[p] < scores[out.winner]) {
+            out.winner = static_cast<uint8_t>(p);
+        }
+    }
+    for (size_t p = 0; p < players; ++p) {
+        if (scores[p] == scores[out.winner]) {
+            out.tiedMask = static_cast<uint8_t>(out.tiedMask | (1u << p));
+        }
+    }
+}
+
+// Implementacija funkcije settleBatch
+void settleBatch(const int* scores, size_t playerCount, size_t games, Settlement* out) {
+    size_t players = playerCount < Settlement::MAX_PLAYERS ? playerCount : Settlement::MAX_PLAYERS;
+    int best[SETTLE_BLOCK];
+    uint8_t tied[SETTLE_BLOCK];
+
+    for (size_t first = 0; first < games; first += SETTLE_BLOCK) {
+        size_t n = games - first < SETTLE_BLOCK ? games - first : SETTLE_BLOCK;
+
+        // Najmanji rezultat po igri
+        for (size_t k = 0; k < n; ++k) {
+            best[k] = players > 0 ? scores[first + k] : 0;
+            tied[k] = 0;
+        }
+        for (size_t p = 1; p < players; ++p) {
+            const int* row = scores + p * games + first;
+            for (size_t k = 0; k < n; ++k) {
+                best[k] = row[k] < best[k] ? row[k] : best[k];
+            }
+        }
+
+        // Maska igrača koji dijele najmanji rezultat
+        for (size_t p = 0; p < players; ++p) {
+            const int* row = scores + p * games + first;
+            for (size_t k = 0; k < n; ++k) {
+                tied[k] = static_cast<uint8_t>(tied[k] | ((row[k] == best[k]) << p));
+            }
+        }
+
+        for (size_t k = 0; k < n; ++k) {
+            Settlement& result = out[first + k];
+            for (size_t p = 0; p < players; ++p) {
+                result.scores[p] = scores[p * games + first + k];
+            }
+            result.playerCount = static_cast<uint8_t>(players);
+            result.tiedMask = tied[k];
+            result.winner = static_cast<uint8_t>(tied[k] ? lowestCard(tied[k]) : 0);
+        }
+    }
+}
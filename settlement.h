@@ -0,0 +1,28 @@
+#ifndef SETTLEMENT_H
+#define SETTLEMENT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Obračun kraja igre bez ispisa: bodovi svih igrača, pobjednik (najmanje bodova) i neriješeni ishodi.
+// Skupna inačica obračunava tisuće završenih igara odjednom iz rasporeda GameBatch.
+struct Settlement {
+    static const size_t MAX_PLAYERS = 8;
+
+    int scores[MAX_PLAYERS];
+    uint8_t playerCount;
+    uint8_t winner;     // prvi igrač s najmanje bodova
+    uint8_t tiedMask;   // bit za svakog igrača s najmanje bodova
+
+    bool tie() const {
+        return (tiedMask & (tiedMask - 1)) != 0;
+    }
+};
+
+// Obračun jedne igre; uzima se najviše MAX_PLAYERS igrača
+void settle(const int* scores, size_t playerCount, Settlement& out);
+
+// Obračun games igara s bodovima u rasporedu [igrač * games + igra]; out prima games zapisa
+void settleBatch(const int* scores, size_t playerCount, size_t games, Settlement* out);
+
+#endif
@@ -0,0 +1,53 @@
+#include "showdown.h"
+#include "deadwood.h"
+#include "layoff.h"
+
+using namespace std;
+
+// Implementacija funkcije scoreShowdown
+void scoreShowdown(const CardMask* hands, size_t players, size_t outSeat, RuleVariant variant, int* scores) {
+    const RuleSet& rules = ruleSet(variant);
+    CardMask melded = 0;
+    int knockerDeadwood = minDeadwood(hands[outSeat], variant, &melded);
+    scores[outSeat] = knockerDeadwood;
+
+    // Ruka izlaznog igrača ima najviše NUM_CARDS / 3 meldova, a rastav uvijek postoji
+    CardMask melds[NUM_CARDS / 3];
+    int meldCount = knockerDeadwood > 0 ? splitMelds(melded, variant, melds) : 0;
+    LayoffIndex layoffs;
+    layoffs.clear();
+    for (int i = 0; i < meldCount && static_cast<size_t>(i) < LayoffIndex::MAX_MELDS; ++i) {
+        layoffs.setExtensions(static_cast<size_t>(i), meldExtensions(melds[i], variant));
+    }
+
+    bool undercut = false;
+    for (size_t step = 1; step < players; ++step) {
+        size_t seat = (outSeat + step) % players;
+        CardMask own = 0;
+        minDeadwood(hands[seat], variant, &own);
+        CardMask deadwood = hands[seat] & ~own;
+
+        // Dodana karta mijenja produžetke svog melda pa se kandidati računaju iznova
+        for (CardMask fits = layoffs.candidates(deadwood); fits; fits = layoffs.candidates(deadwood)) {
+            int card = lowestCard(fits);
+            size_t meld = 0;
+            while (!(layoffs.extensions[meld] & cardBit(card))) {
+                ++meld;
+            }
+            melds[meld] |= cardBit(card);
+            layoffs.setExtensions(meld, meldExtensions(melds[meld], variant));
+            deadwood &= ~cardBit(card);
+        }
+
+        scores[seat] = rawDeadwood(deadwood, variant);
+        if (knockerDeadwood == 0) {
+            scores[seat] += rules.ginBonus;
+        }
+        else if (scores[seat] <= knockerDeadwood) {
+            undercut = true;
+        }
+    }
+    if (undercut) {
+        scores[outSeat] += rules.undercutBonus;
+    }
+}
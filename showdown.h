@@ -0,0 +1,16 @@
+#ifndef SHOWDOWN_H
+#define SHOWDOWN_H
+
+#include "cardmask.h"
+#include "rules.h"
+#include <cstddef>
+
+// Bodovanje ruku na kraju igre u kojoj je igrač outSeat izašao, zajedničko za RummyGame i GameBatch.
+// Izlazni igrač meldira najbolji raspored (minDeadwood). Ostali, redom od sljedećeg mjesta, meldiraju
+// svoje karte pa deadwood dodaju na meldove izlaznog igrača (LayoffIndex); nakon gina nema dodavanja.
+// Bodovi su kazne (manje je bolje): deadwood, uz ginBonus svakom protivniku nakon gina i
+// undercutBonus izlaznom igraču ako neki protivnik ima jednako ili manje deadwooda.
+// Protivnik bira svoje meldove bez obzira na dodavanje pa je to pohlepna, ne optimalna obrana.
+void scoreShowdown(const CardMask* hands, size_t players, size_t outSeat, RuleVariant variant, int* scores);
+
+#endif
@@ -0,0 +1,210 @@
+#include "rummy.h"
+#include "batch.h"
+#include "settlement.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Simulacija botova: skalarni RummyGame i GameBatch na istim sjemenima,
+// uz usporedbu rezultata i obračuna te mjerenje igara u sekundi.
+
+namespace {
+
+void printUsage() {
+    cout << "Usage: rummy_sim [-n games] [-s firstSeed] [-k batchSize] [-p players] [-w weights]"
+        " [-r gin|basic|500] [--lazy] [--recycle maxRecycles] [--scalar|--batch]\n";
+}
+
+// Prosječna duljina igre i vrijeme po potezu (cijela igra podijeljena brojem poteza)
+string turnTiming(uint64_t turns, size_t games, double seconds) {
+    if (turns == 0 || games == 0) {
+        return "";
+    }
+    ostringstream text;
+    text << ", " << static_cast<double>(turns) / static_cast<double>(games) << " turns/game, "
+        << static_cast<uint64_t>(seconds * 1e9 / static_cast<double>(turns)) << " ns/turn";
+    return text.str();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    size_t gameCount = 10000;
+    unsigned firstSeed = 1;
+    size_t batchSize = 256;
+    size_t numPlayers = 2;
+    string weights;
+    bool runScalar = true;
+    bool runBatch = true;
+    DeckMode deckMode = SHUFFLED;
+    RuleVariant variant = GIN_RUMMY;
+    StockPolicy stockPolicy = END_ON_EMPTY_STOCK;
+    size_t maxRecycles = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc) {
+            gameCount = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-s" && i + 1 < argc) {
+            firstSeed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-k" && i + 1 < argc) {
+            batchSize = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-p" && i + 1 < argc) {
+            numPlayers = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-w" && i + 1 < argc) {
+            weights = argv[++i];
+        }
+        else if (arg == "-r" && i + 1 < argc) {
+            if (!parseRuleVariant(argv[++i], variant)) {
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--lazy") {
+            deckMode = LAZY;
+        }
+        else if (arg == "--recycle" && i + 1 < argc) {
+            stockPolicy = RECYCLE_DISCARDS;
+            maxRecycles = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "--scalar") {
+            runBatch = false;
+        }
+        else if (arg == "--batch") {
+            runScalar = false;
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (batchSize == 0) {
+        printUsage();
+        return 1;
+    }
+    if (!GameBatch::supportsPlayers(numPlayers, variant)) {
+        cerr << "Error: " << numPlayers << " players are not supported for " << ruleSet(variant).name
+            << " rules\n";
+        return 1;
+    }
+
+    Evaluator evaluator;
+    if (!weights.empty() && !evaluator.loadWeights(weights)) {
+        cerr << "Error: cannot load weights from " << weights << "\n";
+        return 1;
+    }
+
+    vector<unsigned> seeds(gameCount);
+    for (size_t i = 0; i < gameCount; ++i) {
+        seeds[i] = firstSeed + static_cast<unsigned>(i);
+    }
+
+    vector<int> scalarScores;
+    if (runScalar) {
+        scalarScores.reserve(gameCount * numPlayers);
+        uint64_t turns = 0;
+        uint64_t recycles = 0;
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < gameCount; ++i) {
+            RummyGame game(numPlayers, seeds[i], evaluator, deckMode, variant);
+            game.setStockPolicy(stockPolicy, maxRecycles);
+            vector<int> scores = game.simulate();
+            scalarScores.insert(scalarScores.end(), scores.begin(), scores.end());
+            turns += game.turns();
+            recycles += game.recycleCount();
+            if (stockPolicy == RECYCLE_DISCARDS && !game.cardsConserved()) {
+                cout << "CARDS LOST in scalar game with seed " << seeds[i] << "\n";
+                return 1;
+            }
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "scalar: " << gameCount << " games in " << seconds << " s, "
+            << static_cast<uint64_t>(gameCount / seconds) << " games/s" << turnTiming(turns, gameCount, seconds) << "\n";
+        if (stockPolicy == RECYCLE_DISCARDS) {
+            cout << "scalar: " << recycles << " stock recycles, 52 cards conserved\n";
+        }
+    }
+
+    vector<int> batchScores;
+    vector<Settlement> batchSettlements;
+    vector<size_t> wins(numPlayers + 1, 0);
+    if (runBatch) {
+        batchScores.reserve(gameCount * numPlayers);
+        batchSettlements.reserve(gameCount);
+        vector<Settlement> settlements(batchSize);
+        uint64_t turns = 0;
+        uint64_t recycles = 0;
+        auto start = chrono::steady_clock::now();
+        for (size_t first = 0; first < gameCount; first += batchSize) {
+            size_t count = gameCount - first < batchSize ? gameCount - first : batchSize;
+            GameBatch batch(numPlayers, &seeds[first], count, evaluator, deckMode, variant);
+            batch.setStockPolicy(stockPolicy, maxRecycles);
+            batch.run();
+            turns += batch.turns();
+            recycles += batch.recycleCount();
+            if (stockPolicy == RECYCLE_DISCARDS) {
+                for (size_t k = 0; k < count; ++k) {
+                    if (!batch.cardsConserved(k)) {
+                        cout << "CARDS LOST in batch game with seed " << seeds[first + k] << "\n";
+                        return 1;
+                    }
+                }
+            }
+            batch.settle(settlements.data());
+            for (size_t k = 0; k < count; ++k) {
+                ++wins[settlements[k].tie() ? numPlayers : settlements[k].winner];
+                batchSettlements.push_back(settlements[k]);
+                for (size_t p = 0; p < numPlayers; ++p) {
+                    batchScores.push_back(batch.score(k, p));
+                }
+            }
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "batch:  " << gameCount << " games in " << seconds << " s, "
+            << static_cast<uint64_t>(gameCount / seconds) << " games/s" << turnTiming(turns, gameCount, seconds)
+            << " (K=" << batchSize << ")\n";
+        if (stockPolicy == RECYCLE_DISCARDS) {
+            cout << "batch:  " << recycles << " stock recycles, 52 cards conserved\n";
+        }
+        cout << "wins:";
+        for (size_t p = 0; p < numPlayers; ++p) {
+            cout << " P" << p + 1 << " " << wins[p];
+        }
+        cout << ", ties " << wins[numPlayers] << "\n";
+    }
+
+    if (runScalar && runBatch) {
+        for (size_t i = 0; i < scalarScores.size(); ++i) {
+            if (scalarScores[i] != batchScores[i]) {
+                cout << "MISMATCH in game with seed " << seeds[i / numPlayers] << ", player " << i % numPlayers + 1
+                    << ": scalar " << scalarScores[i] << ", batch " << batchScores[i] << "\n";
+                return 1;
+            }
+        }
+        // Skupni obračun (settleBatch) mora se slagati s obračunom svake igre zasebno (settle)
+        for (size_t i = 0; i < gameCount; ++i) {
+            Settlement expected;
+            settle(&scalarScores[i * numPlayers], numPlayers, expected);
+            const Settlement& actual = batchSettlements[i];
+            if (expected.playerCount != actual.playerCount || expected.winner != actual.winner ||
+                expected.tiedMask != actual.tiedMask) {
+                cout << "SETTLEMENT MISMATCH in game with seed " << seeds[i] << ": scalar winner "
+                    << static_cast<int>(expected.winner) << " tied 0x" << hex << static_cast<int>(expected.tiedMask)
+                    << ", batch winner " << dec << static_cast<int>(actual.winner) << " tied 0x" << hex
+                    << static_cast<int>(actual.tiedMask) << dec << "\n";
+                return 1;
+            }
+        }
+        cout << "scalar and batch results are identical\n";
+    }
+    return 0;
+}
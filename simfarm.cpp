@@ -0,0 +1,375 @@
+#include "rummy.h"
+#include "batch.h"
+#include "livestats.h"
+#include "settlement.h"
+#include "topology.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Farma simulacija: GameBatch na svim jezgrama stroja. Radnici se vežu na procesore po NUMA
+// čvorovima, a sve svoje podatke (kopiju evaluatora, sjemena, batch, obračune) zauzimaju tek
+// nakon vezanja, pa ih politika prvog dodira smješta u memoriju lokalnog čvora. Isto vrijedi i za
+// utor radnika u LiveStats (LiveStats::attach).
+// Nakon svakog komada igara radnik objavljuje sažetak (LiveStats), a glavna dretva periodički
+// ispisuje trenutne procjene i po želji zaustavlja farmu kad SPRT donese odluku.
+// S -w2 farma igra dvoboj: evaluator A (-w) sjedi na jednom mjestu, a B (-w2) na ostalima. Svako
+// dijeljenje igra se jednom za svako mjesto evaluatora A, pa se prednost mjesta poništava. Te igre
+// nisu neovisne, pa SPRT testira očekivani rezultat A po igri na cijelim dijeljenjima (za dva igrača
+// pentanomno), a ne na pojedinačnim igrama. --duel bez -w2 sučeljava A s ugrađenim evaluatorom.
+
+namespace {
+
+// Rezultat jednog radnika; poravnanje sprječava lažno dijeljenje linija predmemorije
+struct alignas(64) WorkerResult {
+    uint64_t games;
+    bool pinned;
+};
+
+struct FarmConfig {
+    size_t gameCount;
+    unsigned firstSeed;
+    size_t numPlayers;
+    size_t batchSize;
+    RuleVariant variant;
+    bool duel;
+};
+
+void printUsage() {
+    cout << "Usage: rummy_simfarm [-n games] [-s firstSeed] [-p players] [-k batchSize] [-t threads] [-w weights]"
+        " [-w2 weightsB|--duel] [-r gin|basic|500] [-i reportSeconds] [--sprt p0 p1] [--no-pin]\n"
+        "With -w2 or --duel every deal is played once per seat of A; -n counts deals and --sprt tests\n"
+        "A's expected score per game (win 1, shared win 1/2) over whole deals\n"
+        "       rummy_simfarm --verify\n";
+}
+
+// Raspored radnika na izmišljenoj topologiji (čvorovi 0, 2 i 5 sa 6, 2 i 4 procesora): udio po čvoru,
+// broj čvora iz sysfs i procesor svakog radnika
+bool verifyAssignment(const CpuTopology& topology, size_t workers, const vector<WorkerSlot>& expected) {
+    vector<WorkerSlot> slots = assignWorkers(topology, workers);
+    bool ok = slots.size() == expected.size();
+    for (size_t w = 0; ok && w < slots.size(); ++w) {
+        ok = slots[w].node == expected[w].node && slots[w].cpu == expected[w].cpu;
+    }
+    cout << "assignWorkers " << workers << " worker(s):";
+    for (const WorkerSlot& slot : slots) {
+        cout << " " << slot.node << "/" << slot.cpu;
+    }
+    cout << (ok ? " ok" : " MISMATCH") << "\n";
+    return ok;
+}
+
+// --verify: parseCpuList i assignWorkers bez oslanjanja na /sys ovog stroja
+bool verifyTopology() {
+    bool ok = true;
+    vector<int> cpus;
+    bool parsed = parseCpuList("0-3,8,10-11\n", cpus);
+    bool listOk = parsed && cpus == vector<int>{ 0, 1, 2, 3, 8, 10, 11 };
+    // Neispravni zapisi se odbijaju
+    const char* INVALID[] = { "", "\n", "x", "3-1", "2-", "-1" };
+    for (const char* text : INVALID) {
+        if (parseCpuList(text, cpus)) {
+            cout << "parseCpuList accepted \"" << text << "\"\n";
+            listOk = false;
+        }
+    }
+    cout << "parseCpuList: " << (listOk ? "ok" : "MISMATCH") << "\n";
+    ok = ok && listOk;
+
+    CpuTopology topology;
+    topology.nodeIds = { 0, 2, 5 };
+    topology.nodeCpus = { { 0, 1, 2, 3, 4, 5 }, { 6, 7 }, { 8, 9, 10, 11 } };
+    ok = verifyAssignment(topology, 12, { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 0, 5 }, { 2, 6 }, { 2, 7 },
+        { 5, 8 }, { 5, 9 }, { 5, 10 }, { 5, 11 } }) && ok;
+    // 3 radnika: udjeli 1.5/0.5/1, jednaki ostaci pa preostali radnik ide manjem indeksu čvora
+    ok = verifyAssignment(topology, 3, { { 0, 0 }, { 0, 1 }, { 5, 8 } }) && ok;
+    // Više radnika nego procesora: udjeli 7/2/5, a procesori čvora se ponavljaju ukrug
+    ok = verifyAssignment(topology, 14, { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 0, 3 }, { 0, 4 }, { 0, 5 }, { 0, 0 }, { 2, 6 },
+        { 2, 7 }, { 5, 8 }, { 5, 9 }, { 5, 10 }, { 5, 11 }, { 5, 8 } }) && ok;
+    return ok;
+}
+
+// Komadi od batchSize dijeljenja dijele se preko atomskog brojača; stop prekida prije sljedećeg komada
+void runWorker(const FarmConfig& config, const Evaluator& sharedA, const Evaluator& sharedB, atomic<size_t>& next,
+    const atomic<bool>& stop, LiveStats& stats, size_t index, WorkerResult& result) {
+    stats.attach(index);
+    Evaluator evaluatorA(sharedA);
+    Evaluator evaluatorB(sharedB);
+    vector<const Evaluator*> seats(config.numPlayers);
+    vector<unsigned> seeds(config.batchSize);
+    vector<Settlement> settlements(config.batchSize);
+    vector<uint8_t> halfPoints(config.batchSize);
+    StatsSketch delta;
+    uint64_t games = 0;
+
+    for (size_t first = next.fetch_add(config.batchSize); first < config.gameCount && !stop.load();
+        first = next.fetch_add(config.batchSize)) {
+        size_t count = config.gameCount - first < config.batchSize ? config.gameCount - first : config.batchSize;
+        for (size_t k = 0; k < count; ++k) {
+            seeds[k] = config.firstSeed + static_cast<unsigned>(first + k);
+        }
+        delta.clear();
+        if (!config.duel) {
+            GameBatch batch(config.numPlayers, seeds.data(), count, evaluatorA, SHUFFLED, config.variant);
+            batch.run();
+            batch.settle(settlements.data());
+            for (size_t k = 0; k < count; ++k) {
+                delta.add(settlements[k]);
+            }
+            games += count;
+        }
+        else {
+            fill(halfPoints.begin(), halfPoints.begin() + count, 0);
+            for (size_t seatA = 0; seatA < config.numPlayers; ++seatA) {
+                for (size_t seat = 0; seat < config.numPlayers; ++seat) {
+                    seats[seat] = seat == seatA ? &evaluatorA : &evaluatorB;
+                }
+                GameBatch batch(config.numPlayers, seeds.data(), count, seats, SHUFFLED, config.variant);
+                batch.run();
+                batch.settle(settlements.data());
+                for (size_t k = 0; k < count; ++k) {
+                    delta.addDuel(settlements[k], seatA);
+                    halfPoints[k] = static_cast<uint8_t>(halfPoints[k] + duelHalfPoints(settlements[k], seatA));
+                }
+                games += count;
+            }
+            for (size_t k = 0; k < count; ++k) {
+                delta.addDeal(halfPoints[k]);
+            }
+        }
+        stats.publish(index, delta);
+    }
+    result.games = games;
+}
+
+// Jedan redak procjena: udio pobjeda s 95 % Wilsonovim intervalom i prosječni rezultat po igraču
+void printEstimates(const StatsSketch& total, double seconds, double intervalRate) {
+    cout << "[" << fixed << setprecision(1) << seconds << " s] " << defaultfloat << setprecision(4)
+        << total.games << " games, "
+        << static_cast<uint64_t>(intervalRate) << " games/s";
+    for (size_t p = 0; p < total.players; ++p) {
+        double low = 0.0;
+        double high = 0.0;
+        wilsonInterval(total.wins[p], total.games, 1.96, low, high);
+        cout << " | P" << p + 1 << " win " << static_cast<double>(total.wins[p]) / (total.games ? total.games : 1)
+            << " [" << low << ", " << high << "] score " << total.meanScore(p);
+    }
+    cout << " | ties " << total.ties;
+    // Interval za A računa se po igrama; igre istog dijeljenja su korelirane pa je samo orijentacijski
+    uint64_t decided = total.duelWins + total.duelLosses;
+    if (decided > 0) {
+        double low = 0.0;
+        double high = 0.0;
+        wilsonInterval(total.duelWins, decided, 1.96, low, high);
+        cout << " | A win " << static_cast<double>(total.duelWins) / decided << " [" << low << ", " << high << "]";
+    }
+    cout << "\n";
+}
+
+void printHistogramSummary(const StatsSketch& total) {
+    const double QUANTILES[] = { 0.1, 0.25, 0.5, 0.75, 0.9, 0.99 };
+    cout << "score quantiles (all hands / winners):";
+    for (double q : QUANTILES) {
+        cout << " p" << static_cast<int>(q * 100) << " "
+            << histogramQuantile(total.scoreHistogram, StatsSketch::SCORE_BINS, q) << "/"
+            << histogramQuantile(total.winnerHistogram, StatsSketch::SCORE_BINS, q);
+    }
+    cout << "\n";
+    for (size_t p = 0; p < total.players; ++p) {
+        cout << "P" << p + 1 << " score " << total.meanScore(p) << " +- " << total.scoreDeviation(p) << "\n";
+    }
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    FarmConfig config = { 100000, 1, 2, 256, GIN_RUMMY, false };
+    size_t threadCount = 0;
+    string weights;
+    string weightsB;
+    bool pin = true;
+    double reportSeconds = 1.0;
+    bool useSprt = false;
+    SprtTest sprt = { 0.5, 0.55, 0.05, 0.05 };
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "-n" && i + 1 < argc) {
+            config.gameCount = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-s" && i + 1 < argc) {
+            config.firstSeed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-p" && i + 1 < argc) {
+            config.numPlayers = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-k" && i + 1 < argc) {
+            config.batchSize = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-t" && i + 1 < argc) {
+            threadCount = static_cast<size_t>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (arg == "-w" && i + 1 < argc) {
+            weights = argv[++i];
+        }
+        else if (arg == "-w2" && i + 1 < argc) {
+            weightsB = argv[++i];
+            config.duel = true;
+        }
+        else if (arg == "--duel") {
+            config.duel = true;
+        }
+        else if (arg == "-r" && i + 1 < argc) {
+            if (!parseRuleVariant(argv[++i], config.variant)) {
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "-i" && i + 1 < argc) {
+            reportSeconds = atof(argv[++i]);
+        }
+        else if (arg == "--sprt" && i + 2 < argc) {
+            useSprt = true;
+            sprt.p0 = atof(argv[++i]);
+            sprt.p1 = atof(argv[++i]);
+        }
+        else if (arg == "--no-pin") {
+            pin = false;
+        }
+        else if (arg == "--verify") {
+            return verifyTopology() ? 0 : 1;
+        }
+        else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (config.batchSize == 0 || (useSprt && !config.duel) ||
+        (useSprt && !(sprt.p0 > 0.0 && sprt.p0 < 1.0 && sprt.p1 > 0.0 && sprt.p1 < 1.0 && sprt.p0 != sprt.p1))) {
+        printUsage();
+        return 1;
+    }
+    if (!GameBatch::supportsPlayers(config.numPlayers, config.variant)) {
+        cerr << "Error: " << config.numPlayers << " players are not supported for " << ruleSet(config.variant).name
+            << " rules\n";
+        return 1;
+    }
+
+    Evaluator evaluatorA;
+    if (!weights.empty() && !evaluatorA.loadWeights(weights)) {
+        cerr << "Error: cannot load weights from " << weights << "\n";
+        return 1;
+    }
+    Evaluator evaluatorB;
+    if (!weightsB.empty() && !evaluatorB.loadWeights(weightsB)) {
+        cerr << "Error: cannot load weights from " << weightsB << "\n";
+        return 1;
+    }
+
+    CpuTopology topology = detectTopology();
+    if (threadCount == 0) {
+        threadCount = topology.cpuCount();
+    }
+    vector<WorkerSlot> slots = assignWorkers(topology, threadCount);
+    cout << "topology: " << topology.nodeCount() << " node(s), " << topology.cpuCount() << " cpu(s), "
+        << threadCount << " worker(s)" << (pin ? "" : ", unpinned") << "\n";
+
+    vector<WorkerResult> results(threadCount);
+    LiveStats stats(threadCount);
+    atomic<size_t> next(0);
+    atomic<bool> stop(false);
+    atomic<size_t> running(threadCount);
+    auto start = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (size_t w = 0; w < threadCount; ++w) {
+        threads.emplace_back([&, w]() {
+            results[w].pinned = pin && pinCurrentThread(slots[w].cpu);
+            runWorker(config, evaluatorA, evaluatorB, next, stop, stats, w, results[w]);
+            --running;
+        });
+    }
+
+    // Glavna dretva samo izvještava: spaja sažetke radnika svakih reportSeconds i provjerava SPRT
+    StatsSketch total;
+    total.clear();
+    uint64_t reportedGames = 0;
+    double reportedAt = 0.0;
+    SprtDecision decision = SPRT_CONTINUE;
+    double llr = 0.0;
+    while (running.load() > 0) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        bool report = reportSeconds > 0.0 && elapsed - reportedAt >= reportSeconds;
+        if (!report && !useSprt) {
+            continue;
+        }
+        stats.snapshot(total);
+        if (useSprt && decision == SPRT_CONTINUE) {
+            decision = sprt.decide(total.dealScores, config.numPlayers, llr);
+            if (decision != SPRT_CONTINUE) {
+                stop = true;
+            }
+        }
+        if (report) {
+            printEstimates(total, elapsed, (total.games - reportedGames) / (elapsed - reportedAt));
+            reportedGames = total.games;
+            reportedAt = elapsed;
+        }
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    stats.snapshot(total);
+
+    // Propusnost po čvoru
+    for (size_t node = 0; node < topology.nodeCount(); ++node) {
+        uint64_t games = 0;
+        size_t workers = 0;
+        size_t pinned = 0;
+        for (size_t w = 0; w < threadCount; ++w) {
+            if (slots[w].node == topology.nodeIds[node]) {
+                games += results[w].games;
+                ++workers;
+                pinned += results[w].pinned;
+            }
+        }
+        if (workers == 0) {
+            continue;
+        }
+        cout << "node " << topology.nodeIds[node] << ": " << workers << " worker(s), " << pinned << " pinned, " << games << " games, "
+            << static_cast<uint64_t>(seconds > 0.0 ? games / seconds : 0.0) << " games/s\n";
+    }
+
+    printEstimates(total, seconds, seconds > 0.0 ? total.games / seconds : 0.0);
+    printHistogramSummary(total);
+    if (useSprt) {
+        if (decision == SPRT_CONTINUE) {
+            decision = sprt.decide(total.dealScores, config.numPlayers, llr);
+        }
+        cout << "SPRT A score " << sprt.p0 << " vs " << sprt.p1 << " over " << total.deals() << " deals: llr " << llr
+            << ", "
+            << (decision == SPRT_ACCEPT_H1 ? "H1 accepted" :
+                decision == SPRT_ACCEPT_H0 ? "H0 accepted" : "inconclusive")
+            << (stop ? " (stopped early)" : "") << "\n";
+    }
+
+    // Zbroj bodova ne ovisi o broju dretvi pa služi kao kontrolni zbroj (bez ranog zaustavljanja)
+    int64_t scoreSum = 0;
+    for (size_t p = 0; p < total.players; ++p) {
+        scoreSum += total.scoreSum[p];
+    }
+    cout << "total: " << total.games << " games in " << seconds << " s, "
+        << static_cast<uint64_t>(seconds > 0.0 ? total.games / seconds : 0.0) << " games/s\n"
+        << "ties " << total.ties << ", score checksum " << scoreSum << "\n";
+    return 0;
+}
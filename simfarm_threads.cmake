@@ -0,0 +1,22 @@
+# Farma s jednom i s više dretvi mora dati isti broj igara i isti kontrolni zbroj bodova.
+# Poziv: cmake -DSIMFARM=<rummy_simfarm> -DTHREADS=<n> "-DARGS=<argumenti>" -P simfarm_threads.cmake
+separate_arguments(farmArgs UNIX_COMMAND "${ARGS}")
+foreach(threads 1 ${THREADS})
+    execute_process(COMMAND ${SIMFARM} ${farmArgs} -t ${threads} -i 0
+        OUTPUT_VARIABLE output RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "rummy_simfarm -t ${threads} failed (${result}):\n${output}")
+    endif()
+    string(REGEX MATCH "total: [0-9]+ games" games "${output}")
+    string(REGEX MATCH "score checksum -?[0-9]+" checksum "${output}")
+    if(games STREQUAL "" OR checksum STREQUAL "")
+        message(FATAL_ERROR "no checksum in rummy_simfarm -t ${threads} output:\n${output}")
+    endif()
+    message(STATUS "-t ${threads}: ${games}, ${checksum}")
+    list(APPEND results "${games}, ${checksum}")
+endforeach()
+list(GET results 0 single)
+list(GET results 1 multiple)
+if(NOT single STREQUAL multiple)
+    message(FATAL_ERROR "-t 1 and -t ${THREADS} differ: ${single} / ${multiple}")
+endif()
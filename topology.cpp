@@ -0,0 +1,199 @@
+#include "topology.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+bool readLine(const string& path, string& line) {
+    ifstream in(path);
+    return in && getline(in, line);
+}
+
+// Procesori na kojima proces smije raditi (maska afiniteta, npr. ograničenje kontejnera)
+vector<int> allowedCpus() {
+    vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        int count = static_cast<int>(thread::hardware_concurrency());
+        for (int cpu = 0; cpu < (count > 0 ? count : 1); ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+// Redni broj procesora među SMT blizancima iste fizičke jezgre (0 za prvog)
+int smtRank(int cpu) {
+    string line;
+    vector<int> siblings;
+    if (!readLine("/sys/devices/system/cpu/cpu" + to_string(cpu) + "/topology/thread_siblings_list", line) ||
+        !parseCpuList(line, siblings)) {
+        return 0;
+    }
+    auto it = find(siblings.begin(), siblings.end(), cpu);
+    return it == siblings.end() ? 0 : static_cast<int>(it - siblings.begin());
+}
+
+}
+
+// Implementacija funkcije nodeCount
+size_t CpuTopology::nodeCount() const {
+    return nodeCpus.size();
+}
+
+// Implementacija funkcije cpuCount
+size_t CpuTopology::cpuCount() const {
+    size_t count = 0;
+    for (const auto& cpus : nodeCpus) {
+        count += cpus.size();
+    }
+    return count;
+}
+
+// Implementacija funkcije parseCpuList
+bool parseCpuList(const string& text, vector<int>& cpus) {
+    cpus.clear();
+    size_t pos = 0;
+    while (pos < text.size() && text[pos] != '\n') {
+        char* end = nullptr;
+        long first = strtol(text.c_str() + pos, &end, 10);
+        if (end == text.c_str() + pos || first < 0) {
+            return false;
+        }
+        long last = first;
+        pos = static_cast<size_t>(end - text.c_str());
+        if (pos < text.size() && text[pos] == '-') {
+            const char* start = text.c_str() + pos + 1;
+            last = strtol(start, &end, 10);
+            if (end == start || last < first) {
+                return false;
+            }
+            pos = static_cast<size_t>(end - text.c_str());
+        }
+        for (long cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(static_cast<int>(cpu));
+        }
+        if (pos < text.size() && text[pos] == ',') {
+            ++pos;
+        }
+    }
+    return !cpus.empty();
+}
+
+// Implementacija funkcije detectTopology
+CpuTopology detectTopology() {
+    vector<int> allowed = allowedCpus();
+    CpuTopology topology;
+
+    string line;
+    vector<int> nodes;
+    if (readLine("/sys/devices/system/node/online", line) && parseCpuList(line, nodes)) {
+        for (int node : nodes) {
+            vector<int> cpus;
+            if (!readLine("/sys/devices/system/node/node" + to_string(node) + "/cpulist", line) ||
+                !parseCpuList(line, cpus)) {
+                continue;
+            }
+            vector<pair<int, int>> ranked;
+            for (int cpu : cpus) {
+                if (find(allowed.begin(), allowed.end(), cpu) != allowed.end()) {
+                    ranked.push_back({ smtRank(cpu), cpu });
+                }
+            }
+            if (ranked.empty()) {
+                continue;
+            }
+            sort(ranked.begin(), ranked.end());
+            topology.nodeIds.push_back(node);
+            topology.nodeCpus.push_back(vector<int>());
+            for (const auto& entry : ranked) {
+                topology.nodeCpus.back().push_back(entry.second);
+            }
+        }
+    }
+
+    if (topology.nodeCpus.empty()) {
+        topology.nodeIds.push_back(0);
+        topology.nodeCpus.push_back(allowed);
+    }
+    return topology;
+}
+
+// Implementacija funkcije assignWorkers
+vector<WorkerSlot> assignWorkers(const CpuTopology& topology, size_t workers) {
+    size_t nodes = topology.nodeCount();
+    size_t cpuTotal = topology.cpuCount();
+    vector<size_t> shares(nodes, 0);
+    vector<size_t> remainders(nodes, 0);
+    size_t assigned = 0;
+    for (size_t node = 0; node < nodes; ++node) {
+        size_t scaled = workers * topology.nodeCpus[node].size();
+        shares[node] = scaled / cpuTotal;
+        remainders[node] = scaled % cpuTotal;
+        assigned += shares[node];
+    }
+    // Preostali radnici (manje od broja čvorova) idu čvorovima s najvećim ostatkom, kod jednakih manjem indeksu
+    for (; assigned < workers; ++assigned) {
+        size_t best = 0;
+        for (size_t node = 1; node < nodes; ++node) {
+            if (remainders[node] > remainders[best]) {
+                best = node;
+            }
+        }
+        ++shares[best];
+        remainders[best] = 0;
+    }
+
+    vector<WorkerSlot> slots;
+    for (size_t node = 0; node < nodes; ++node) {
+        const vector<int>& cpus = topology.nodeCpus[node];
+        for (size_t i = 0; i < shares[node]; ++i) {
+            slots.push_back({ topology.nodeIds[node], cpus[i % cpus.size()] });
+        }
+    }
+    return slots;
+}
+
+// Implementacija funkcije pinCurrentThread
+bool pinCurrentThread(int cpu) {
+#ifdef _WIN32
+    if (cpu < 0 || cpu >= 64) {
+        return false;
+    }
+    return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu) != 0;
+#elif defined(__linux__)
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
@@ -0,0 +1,38 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Raspored procesora po NUMA čvorovima, pročitan iz /sys/devices/system/node i
+// /sys/devices/system/cpu. Unutar čvora procesori su poredani tako da prvo dolazi po jedna
+// logička jezgra svake fizičke jezgre, a tek onda SMT blizanci, pa radnici ne dijele L1/L2 dok ima
+// slobodnih jezgri. Bez /sys (Windows, kontejneri bez sysfs) cijeli stroj je jedan čvor.
+struct CpuTopology {
+    std::vector<int> nodeIds;                 // broj čvora iz sysfs (nodeN), redom kao nodeCpus
+    std::vector<std::vector<int>> nodeCpus;
+
+    size_t nodeCount() const;
+    size_t cpuCount() const;
+};
+
+// Mjesto radnika: čvor (broj iz sysfs, kao u CpuTopology::nodeIds) i procesor na koji se veže
+struct WorkerSlot {
+    int node;
+    int cpu;
+};
+
+CpuTopology detectTopology();
+
+// Svaki čvor dobiva dio radnika razmjeran broju svojih procesora (ostatak ide čvorovima s najvećim
+// razlomljenim dijelom), a unutar čvora radnici idu redom po procesorima čvora
+std::vector<WorkerSlot> assignWorkers(const CpuTopology& topology, size_t workers);
+
+// Veže pozivajuću dretvu na procesor; false ako sustav to ne podržava ili odbije
+bool pinCurrentThread(int cpu);
+
+// Popis procesora u obliku "0-3,8,10-11"; false za neispravan zapis
+bool parseCpuList(const std::string& text, std::vector<int>& cpus);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstdint>
+
+// Zapis jednog poteza u 16 bita za korpus odigranih igara:
+//   bitovi 0-5   izvučena karta
+//   bit 6        karta je uzeta s hrpe
+//   bitovi 7-12  odbačena karta
+// Igrač na potezu slijedi iz rednog broja poteza pa se ne zapisuje.
+typedef uint16_t TraceEvent;
+
+inline TraceEvent makeTraceEvent(int drawn, bool tookDiscard, int thrown) {
+    return static_cast<TraceEvent>(drawn | (tookDiscard ? 1 << 6 : 0) | (thrown << 7));
+}
+
+inline int traceDrawn(TraceEvent event) { return event & 0x3F; }
+inline bool traceTookDiscard(TraceEvent event) { return (event >> 6) & 1; }
+inline int traceThrown(TraceEvent event) { return (event >> 7) & 0x3F; }
+
+#endif